@@ -0,0 +1,185 @@
+#include "ansim.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace {
+
+struct Transition {
+  int automaton, to;
+  std::vector<int> guard;       // slices which must all be set, origin included
+};
+
+// The states of a batch, one word per slice and block of 64 states, stored
+// slice by slice so that the loops over blocks in 'fireable' vectorize.
+
+struct Batch {
+  int size, blocks;
+  std::vector<uint64_t> words;
+  const uint64_t * slice (int i) const { return &words[(size_t) i * blocks]; }
+};
+
+}
+
+struct ansim {
+
+  int automata;
+  std::vector<int> domain, offset;      // first slice of each automaton
+  int slices;
+  std::vector<Transition> transitions;
+
+  ansim (int n, const int * domain_sizes) :
+    automata (n), domain (domain_sizes, domain_sizes + n), offset (n), slices (0)
+  {
+    for (int a = 0; a < n; a++) offset[a] = slices, slices += domain[a];
+  }
+
+  bool valid (const int * state) const {
+    for (int a = 0; a < automata; a++)
+      if (state[a] < 0 || state[a] >= domain[a]) return false;
+    return true;
+  }
+
+  bool pack (const int * states, int size, Batch & batch) const {
+    batch.size = size;
+    batch.blocks = (size + 63) / 64;
+    batch.words.assign ((size_t) slices * batch.blocks, 0);
+    for (int s = 0; s < size; s++) {
+      const int * state = states + (size_t) s * automata;
+      if (!valid (state)) return false;
+      for (int a = 0; a < automata; a++) {
+        size_t i = (size_t) (offset[a] + state[a]) * batch.blocks + s / 64;
+        batch.words[i] |= (uint64_t) 1 << (s % 64);
+      }
+    }
+    return true;
+  }
+
+  void fireable (const Transition & t, const Batch & batch,
+                 std::vector<uint64_t> & mask) const {
+    mask.assign (batch.blocks, ~(uint64_t) 0);
+    uint64_t * m = mask.data ();
+    for (int g : t.guard) {
+      const uint64_t * w = batch.slice (g);
+      for (int b = 0; b < batch.blocks; b++) m[b] &= w[b];
+    }
+    if (batch.size % 64)
+      m[batch.blocks - 1] &= ((uint64_t) 1 << (batch.size % 64)) - 1;
+  }
+
+  // Marks in 'enabled' the states of the batch with a fireable transition.
+  //
+  void enabled (const Batch & batch, std::vector<uint64_t> & enabled) const {
+    enabled.assign (batch.blocks, 0);
+    std::vector<uint64_t> mask;
+    for (const Transition & t : transitions) {
+      fireable (t, batch, mask);
+      for (int b = 0; b < batch.blocks; b++) enabled[b] |= mask[b];
+    }
+  }
+};
+
+static bool reaches_all (const std::vector<std::vector<int>> & edges) {
+  std::vector<bool> reached (edges.size (), false);
+  std::vector<int> work (1, 0);
+  size_t count = 1;
+  reached[0] = true;
+  while (!work.empty ()) {
+    int s = work.back ();
+    work.pop_back ();
+    for (int t : edges[s])
+      if (!reached[t]) reached[t] = true, count++, work.push_back (t);
+  }
+  return count == edges.size ();
+}
+
+extern "C" {
+
+ansim * ansim_new (int automata, const int * domain_sizes) {
+  return new ansim (automata, domain_sizes);
+}
+
+void ansim_release (ansim * sim) { delete sim; }
+
+void ansim_add_transition (ansim * sim, int automaton, int from, int to,
+                           const int * conditions, int size) {
+  Transition t;
+  t.automaton = automaton;
+  t.to = to;
+  t.guard.push_back (sim->offset[automaton] + from);
+  for (int i = 0; i < size; i++) {
+    int a = conditions[2*i], v = conditions[2*i + 1];
+    t.guard.push_back (sim->offset[a] + v);
+  }
+  sim->transitions.push_back (t);
+}
+
+int ansim_filter_fixed_points (ansim * sim, const int * states, int size,
+                               int * result) {
+  Batch batch;
+  if (!sim->pack (states, size, batch)) {
+    // out of domain states are not fixed points, the others are checked
+    // one by one
+    int count = 0;
+    for (int s = 0; s < size; s++) {
+      const int * state = states + (size_t) s * sim->automata;
+      result[s] = sim->valid (state) && ansim_is_fixed_point (sim, state);
+      count += result[s];
+    }
+    return count;
+  }
+  std::vector<uint64_t> enabled;
+  sim->enabled (batch, enabled);
+  int count = 0;
+  for (int s = 0; s < size; s++) {
+    result[s] = !((enabled[s / 64] >> (s % 64)) & 1);
+    count += result[s];
+  }
+  return count;
+}
+
+int ansim_is_fixed_point (ansim * sim, const int * state) {
+  int result;
+  return ansim_filter_fixed_points (sim, state, 1, &result);
+}
+
+int ansim_is_attractor (ansim * sim, const int * states, int size) {
+  if (size <= 0) return 0;
+  Batch batch;
+  if (!sim->pack (states, size, batch)) return 0;
+
+  const int n = sim->automata;
+  std::map<std::vector<int>, int> index;
+  for (int s = 0; s < size; s++) {
+    const int * state = states + (size_t) s * n;
+    if (!index.emplace (std::vector<int> (state, state + n), s).second)
+      return 0;
+  }
+
+  // every successor must be in the set (closed) ...
+  std::vector<std::vector<int>> next (size), prev (size);
+  std::vector<uint64_t> mask;
+  std::vector<int> successor (n);
+  for (const Transition & t : sim->transitions) {
+    sim->fireable (t, batch, mask);
+    for (int b = 0; b < batch.blocks; b++) {
+      for (uint64_t m = mask[b]; m; m &= m - 1) {
+        int s = 64 * b + __builtin_ctzll (m);
+        const int * state = states + (size_t) s * n;
+        successor.assign (state, state + n);
+        successor[t.automaton] = t.to;
+        auto it = index.find (successor);
+        if (it == index.end ()) return 0;
+        next[s].push_back (it->second);
+        prev[it->second].push_back (s);
+      }
+    }
+  }
+
+  // ... and all states must reach each other (strongly connected)
+  return reaches_all (next) && reaches_all (prev);
+}
+
+}
@@ -0,0 +1,49 @@
+#ifndef _ansim_h_INCLUDED
+#define _ansim_h_INCLUDED
+
+/*------------------------------------------------------------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*------------------------------------------------------------------------*/
+
+// Asynchronous simulator for automata networks, meant to be loaded over JNA
+// next to the IPASIR library.  States are given as arrays with one value per
+// automaton (in the order of 'ansim_new').  Internally states are bit-sliced
+// with one 64-bit word per (automaton, value) pair and block of 64 states,
+// so that a transition guard is evaluated for 64 states with a few 'and's.
+
+typedef struct ansim ansim;
+
+ansim * ansim_new (int automata, const int * domain_sizes);
+void ansim_release (ansim *);
+
+// Transition of 'automaton' from value 'from' to 'to' under the conditions
+// given as 'size' pairs (automaton, value) in 'conditions'.
+//
+void ansim_add_transition (ansim *, int automaton, int from, int to,
+                           const int * conditions, int size);
+
+// Returns 1 if no transition can be fired from 'state'.
+//
+int ansim_is_fixed_point (ansim *, const int * state);
+
+// Sets 'result[i]' to 1 if the state at 'states + i * automata' is a fixed
+// point and to 0 otherwise, and returns the number of fixed points.
+//
+int ansim_filter_fixed_points (ansim *, const int * states, int size,
+                               int * result);
+
+// Returns 1 if the 'size' states at 'states' form a terminal strongly
+// connected component of the state transition graph, that is an attractor,
+// and 0 otherwise (also for repeated or out of domain states).
+//
+int ansim_is_attractor (ansim *, const int * states, int size);
+
+/*------------------------------------------------------------------------*/
+#ifdef __cplusplus
+}
+#endif
+/*------------------------------------------------------------------------*/
+
+#endif
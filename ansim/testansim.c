@@ -0,0 +1,56 @@
+#include "ansim.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+// a <-> b toggle each other's partner (cyclic attractor over four states)
+// while c is Boolean and goes 0 -> 1 unconditionally, d has three values
+// and goes 0 -> 2 when c = 1.
+
+int main () {
+  int domains[] = { 2, 2, 2, 3 };
+  ansim * sim = ansim_new (4, domains);
+  int b0[] = { 1, 0 }, b1[] = { 1, 1 }, a0[] = { 0, 0 }, a1[] = { 0, 1 };
+  int c1[] = { 2, 1 };
+  ansim_add_transition (sim, 0, 0, 1, b0, 1);
+  ansim_add_transition (sim, 0, 1, 0, b1, 1);
+  ansim_add_transition (sim, 1, 0, 1, a1, 1);
+  ansim_add_transition (sim, 1, 1, 0, a0, 1);
+  ansim_add_transition (sim, 2, 0, 1, 0, 0);
+  ansim_add_transition (sim, 3, 0, 2, c1, 1);
+
+  int cycle[] = { 0, 0, 1, 2,  1, 0, 1, 2,  1, 1, 1, 2,  0, 1, 1, 2 };
+  assert (ansim_is_attractor (sim, cycle, 4));
+  assert (!ansim_is_attractor (sim, cycle, 3));         // not closed
+  int open[] = { 0, 0, 0, 2,  1, 0, 0, 2,  1, 1, 0, 2,  0, 1, 0, 2 };
+  assert (!ansim_is_attractor (sim, open, 4));          // c can still fire
+  int twice[] = { 0, 0, 1, 2,  0, 0, 1, 2 };
+  assert (!ansim_is_attractor (sim, twice, 2));
+  int out[] = { 0, 0, 1, 3 };
+  assert (!ansim_is_attractor (sim, out, 1));
+  assert (!ansim_is_fixed_point (sim, out));
+
+  ansim_release (sim);
+
+  // without the a/b cycle every state with c = 1 and d != 0 is fixed
+  sim = ansim_new (4, domains);
+  ansim_add_transition (sim, 2, 0, 1, 0, 0);
+  ansim_add_transition (sim, 3, 0, 2, c1, 1);
+  int states[4 * 100], result[100], expected = 0;
+  for (int s = 0; s < 100; s++) {
+    int * state = states + 4*s;
+    state[0] = s & 1, state[1] = (s >> 1) & 1;
+    state[2] = (s >> 2) & 1, state[3] = s % 3;
+    expected += state[2] && state[3];
+  }
+  assert (ansim_filter_fixed_points (sim, states, 100, result) == expected);
+  for (int s = 0; s < 100; s++) {
+    assert (result[s] == (states[4*s + 2] && states[4*s + 3]));
+    assert (result[s] == ansim_is_fixed_point (sim, states + 4*s));
+    assert (result[s] == ansim_is_attractor (sim, states + 4*s, 1));
+  }
+  ansim_release (sim);
+
+  printf ("ansim: all tests passed\n");
+  return 0;
+}
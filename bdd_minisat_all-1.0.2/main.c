@@ -33,6 +33,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 // #include <unistd.h>
 #include <signal.h>
@@ -48,9 +49,10 @@ DdManager *dd_mgr = NULL; //!< BDD/ZDD manager for CUDD
 #endif
 
 // Reads an input stream to end-of-file and returns the result as a 'char*' terminated by '\0'
-// (dynamic allocation in case 'in' is standard input).
+// (dynamic allocation in case 'in' is standard input).  The number of bytes read is stored in
+// 'length', binary inputs may contain '\0'.
 //
-char *readFile(FILE *in)
+char *readFile(FILE *in, int *length)
 {
     char *data = malloc(65536);
     int cap = 65536;
@@ -67,6 +69,7 @@ char *readFile(FILE *in)
     }
     data = realloc(data, size + 1);
     data[size] = '\0';
+    *length = size;
 
     return data;
 }
@@ -159,12 +162,63 @@ static lbool parse_DIMACS_main(char *in, solver *s)
     return solver_simplify(s);
 }
 
+// Clauses after a 'p bcnf <vars> <clauses>' header, as written by the CNF cache of SAF: each
+// literal 'l' is the number '2*abs(l) + (l < 0)' in 7-bit little endian chunks (the highest bit
+// is set on all but the last byte), and a zero byte ends each clause.
+//
+static lbool parse_BCNF_main(char *in, char *end, solver *s)
+{
+    veci lits;
+    veci_new(&lits);
+
+    skipLine(&in);
+    while (in < end)
+    {
+        unsigned code = 0;
+        int shift = 0;
+        for (;;)
+        {
+            if (in == end || shift > 28)
+                fprintf(stderr, "PARSE ERROR! Truncated or too large binary literal\n"), exit(1);
+            unsigned char byte = (unsigned char)*in++;
+            code |= (unsigned)(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                break;
+            shift += 7;
+        }
+        if (code == 0)
+        {
+            lit *begin = veci_begin(&lits);
+            if (!solver_addclause(s, begin, begin + veci_size(&lits)))
+            {
+                veci_delete(&lits);
+                return l_False;
+            }
+            veci_resize(&lits, 0);
+        }
+        else
+        {
+            int var = (int)(code >> 1) - 1;
+            if (var < 0)
+                fprintf(stderr, "PARSE ERROR! Invalid binary literal\n"), exit(1);
+            veci_push(&lits, (code & 1) ? lit_neg(toLit(var)) : toLit(var));
+        }
+    }
+    if (veci_size(&lits) != 0)
+        fprintf(stderr, "PARSE ERROR! Last clause without terminating zero\n"), exit(1);
+    veci_delete(&lits);
+    return solver_simplify(s);
+}
+
 // Inserts problem into solver. Returns FALSE upon immediate conflict.
 //
 static lbool parse_DIMACS(FILE *in, solver *s)
 {
-    char *text = readFile(in);
-    lbool ret = parse_DIMACS_main(text, s);
+    int length;
+    char *text = readFile(in, &length);
+    lbool ret = strncmp(text, "p bcnf ", 7) == 0
+                    ? parse_BCNF_main(text, text + length, s)
+                    : parse_DIMACS_main(text, s);
     free(text);
     return ret;
 }
@@ -464,7 +464,7 @@ inline int Internal::find_conflict_level (int & forced) {
     if (highest_position > 1)
       {
         LOG (conflict, "unwatch %d in", lit);
-        remove_watch (watches (lit), conflict);
+        remove_watch (watches (lit), arena.reference (conflict));
       }
 
     lits[highest_position] = lit;
@@ -1,30 +1,205 @@
 #include "internal.hpp"
 
+#ifdef __WIN32
+#include <windows.h>
+#else
+extern "C" {
+#include <sys/mman.h>
+#include <unistd.h>
+}
+#endif
+
 namespace CaDiCaL {
 
-Arena::Arena (Internal * i) {
-  memset (this, 0, sizeof *this);
-  internal = i;
+// Spaces are reserved with at least this size and at most the largest
+// range addressable by 30-bit references in units of 8 bytes.
+
+static const bool wide = sizeof (size_t) > 4;
+static const size_t initial_capacity = (size_t) 1 << (wide ? 26 : 24);
+static const size_t maximum_capacity = (size_t) 1 << (wide ? 33 : 30);
+
+// Reserve a range of virtual memory without backing it by memory.
+
+static char * reserve (size_t bytes) {
+#ifdef __WIN32
+  return (char *) VirtualAlloc (0, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  void * res = mmap (0, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+  return res == MAP_FAILED ? 0 : (char *) res;
+#endif
+}
+
+// The operating system only gives back whole pages.
+
+static size_t page_size () {
+#ifdef __WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo (&info);
+  return info.dwPageSize;
+#else
+  return sysconf (_SC_PAGESIZE);
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+Arena::Arena (Internal * i) :
+  internal (i), moved (0), copying (false)
+{
+  from.start = from.top = from.end = from.limit = 0;
+  to.start = to.top = to.end = to.limit = 0;
+  reserve (from, initial_capacity, 0);
+  moved = from.start;
 }
 
 Arena::~Arena () {
-  delete [] from.start;
-  delete [] to.start;
+  unreserve (from);
+  unreserve (to);
 }
 
+// Reserve 'wanted' bytes for an empty space, or less if the system
+// refuses, but not less than 'needed' bytes.  If this fails too, the space
+// stays empty and all its clauses are allocated outside.
+
+void Arena::reserve (Space & s, size_t wanted, size_t needed) {
+  assert (!s.start), assert (s.outside.empty ());
+  if (wanted > maximum_capacity) wanted = maximum_capacity;
+  if (needed > wanted) needed = wanted;
+  char * p = 0;
+  size_t bytes = wanted;
+  for (;;) {
+    if ((p = CaDiCaL::reserve (bytes))) break;
+    if ((bytes /= 2) < needed || bytes < page_size ()) break;
+  }
+  if (!p) {
+    LOG ("failed to reserve %zd bytes for arena space", needed);
+    return;
+  }
+  LOG ("reserved %zd bytes for arena space", bytes);
+  s.start = s.top = p;
+  s.limit = p + bytes;
+#ifdef __WIN32
+  s.end = p;
+#else
+  s.end = s.limit;
+#endif
+}
+
+void Arena::unreserve (Space & s) {
+  for (const auto & p : s.outside)
+    delete [] (p - sizeof (size_t));
+  erase_vector (s.outside);
+  if (s.start) {
+#ifdef __WIN32
+    VirtualFree (s.start, 0, MEM_RELEASE);
+#else
+    munmap (s.start, s.limit - s.start);
+#endif
+  }
+  s.start = s.top = s.end = s.limit = 0;
+}
+
+// Make at least 'bytes' more bytes above 'top' usable, which is only
+// necessary (and possible) on Windows as long as the range is not full.
+// Memory is committed in steps of at least 1 MB.
+
+bool Arena::commit (Space & s, size_t bytes) {
+#ifdef __WIN32
+  const size_t commit_step = (size_t) 1 << 20;
+  if ((size_t) (s.limit - s.top) < bytes) return false;
+  const size_t wanted = align ((s.top - s.start) +
+    (bytes < commit_step ? commit_step : bytes), page_size ());
+  char * end = s.start + wanted;
+  if (end > s.limit) end = s.limit;
+  if (!VirtualAlloc (s.end, end - s.end, MEM_COMMIT, PAGE_READWRITE))
+    return false;
+  s.end = end;
+  return true;
+#else
+  (void) s, (void) bytes;
+  return false;
+#endif
+}
+
+// Give back the physical memory above 'p' (page aligned) but keep the
+// range reserved.  On Windows the memory is decommitted.
+
+void Arena::release (Space & s, char * p) {
+  assert (s.start <= p);
+#ifdef __WIN32
+  if (p < s.end) VirtualFree (p, s.end - p, MEM_DECOMMIT), s.end = p;
+#else
+  if (p < s.top) madvise (p, s.top - p, MADV_DONTNEED);
+#endif
+}
+
+// Called if the usable memory of the space is exhausted.  Unless more
+// memory can be committed the clause is allocated outside of the arena,
+// prefixed by its index in 'outside' (to find its reference).
+
+char * Arena::overflow (Space & s, size_t bytes) {
+  char * res = s.top;
+  if (commit (s, bytes)) {
+    s.top += bytes;
+    return res;
+  }
+  const size_t index = s.outside.size ();
+  if (index == outside_bit)
+    FATAL ("more than %u clauses outside of clause arena", outside_bit);
+  res = new char[sizeof (size_t) + bytes];
+  *(size_t *) res = index;
+  res += sizeof (size_t);
+  s.outside.push_back (res);
+  LOG ("allocated %zd bytes outside of arena space", bytes);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// The 'to' space is reserved again unless its size is within a factor of
+// two of twice the prepared memory (rounded up to a power of two), which
+// leaves room for new clauses until the next collection.
+
 void Arena::prepare (size_t bytes) {
   LOG ("preparing 'to' space of arena with %zd bytes", bytes);
-  assert (!to.start);
-  to.top = to.start = new char[bytes];
-  to.end = to.start + bytes;
+  assert (to.top == to.start), assert (to.outside.empty ());
+  size_t wanted = initial_capacity;
+  while (wanted < maximum_capacity && wanted < 2*bytes) wanted *= 2;
+  const size_t capacity = to.limit - to.start;
+  if (capacity < wanted || capacity > 2*wanted) {
+    unreserve (to);
+    reserve (to, wanted, bytes);
+  }
+  if ((size_t) (to.end - to.top) < bytes) commit (to, bytes);
+  copying = true;
+}
+
+void Arena::shrink (char * top, char * localized) {
+  assert (from.start <= localized), assert (localized <= top);
+  assert (top <= from.top);
+  assert (from.outside.empty ());
+  release (from, from.start + align (top - from.start, page_size ()));
+  LOG ("shrunken 'from' space of arena from %zd to %zd bytes",
+    (size_t) (from.top - from.start), (size_t) (top - from.start));
+  from.top = top;
+  moved = localized;
 }
 
 void Arena::swap () {
-  delete [] from.start;
-  LOG ("delete 'from' space of arena with %zd bytes",
-    (size_t) (from.end - from.start));
-  from = to;
-  to.start = to.top = to.end = 0;
+  LOG ("released 'from' space of arena with %zd bytes and %zd outside",
+    (size_t) (from.top - from.start), from.outside.size ());
+  release (from, from.start);
+  for (const auto & p : from.outside)
+    delete [] (p - sizeof (size_t));
+  erase_vector (from.outside);
+  from.top = from.start;
+  std::swap (from, to);
+  moved = from.top;
+  copying = false;
 }
 
 }
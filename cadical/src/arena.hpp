@@ -1,101 +1,189 @@
 #ifndef _arena_hpp_INCLUDED
 #define _arena_hpp_INCLUDED
 
-namespace CaDiCaL {
+#include <vector>
 
-// This memory allocation arena provides fixed size pre-allocated memory for
-// the moving garbage collector 'copy_non_garbage_clauses' in 'collect.cpp'
-// to hold clauses which should survive garbage collection.
+namespace CaDiCaL {
 
-// The advantage of using a pre-allocated arena is that the allocation order
+using namespace std;
+
+// This memory arena holds all clauses.  Clauses never move except during
+// garbage collection, and thus can be referenced by 32-bit offsets (in
+// units of 8 bytes, since clauses are 8 byte aligned) from the start of
+// the space holding them.  These references are used in watches (see
+// 'watch.hpp') which then only need 8 bytes instead of 16 bytes with a
+// 64-bit pointer.  There are two spaces, each a separately reserved range
+// of virtual memory, the 'from' space in which new clauses are allocated by
+// bumping 'from.top' and the 'to' space used by the moving garbage
+// collector 'copy_non_garbage_clauses' in 'collect.cpp'.  Pages are only
+// backed by physical memory when touched (on Windows they are committed on
+// demand) and the 'from' space is released to the operating system after
+// it has been swapped with 'to'.
+
+// Spaces start small and are grown during garbage collection, where 'to'
+// is reserved again with twice the size of the clauses moved into it (up
+// to 8 GB, the range addressable with 30 bits).  Clauses which do not fit
+// into their space, because it is exhausted before the next collection or
+// because more than 8 GB of clauses are alive, are allocated outside of
+// the arena and referenced by their index in 'outside' with the otherwise
+// unused bit 30 set (one more bit of a watch reference denotes binary
+// clauses).  Thus there is no hard limit on the memory used by clauses.
+// The next garbage collection moves them back into the (then larger) arena.
+
+// The advantage of a moving garbage collector is that the allocation order
 // of the clauses can be adapted in such a way that clauses watched by the
 // same literal are allocated consecutively.  This improves locality during
 // propagation and thus is more cache friendly. A similar technique is
 // implemented in MiniSAT and Glucose and gives substantial speed-up in
-// propagations per second even though it might even almost double peek
-// memory usage.  Note that in MiniSAT this arena is actually required for
-// MiniSAT to be able to use 32 bit clauses references instead of 64 bit
-// pointers.  This would restrict the maximum number of clauses and thus is
-// a restriction we do not want to use anymore.
-
-// New learned clauses are allocated in CaDiCaL outside of this arena and
-// moved to the arena during garbage collection.  The additional 'to' space
-// required for such a moving garbage collector is only allocated for those
-// clauses surviving garbage collection, which usually needs much less
-// memory than all clauses.  The net effect is that in our implementation
-// the moving garbage collector using this arena only needs roughly 50% more
-// memory than allocating the clauses directly.  Both implementations can be
-// compared by varying the 'opts.arenatype' option (which also controls the
-// allocation order of clauses during moving them).
+// propagations per second.
+
+// Clauses are only deleted during garbage collection and every collection
+// reclaims all the memory of deleted clauses.  Thus there is no need for
+// free lists, and if clauses are not localized, garbage collection instead
+// slides them down in place with 'bottom' and 'shrink', which avoids
+// touching the 'to' space, as long as the 'from' space 'fits' them.
 
 // The standard sequence of using the arena is as follows:
 //
 //   Arena arena;
 //   ...
-//   arena.prepare (bytes);
-//   q1 = arena.copy (p1, bytes1);
-//   ...
-//   qn = arena.copy (pn, bytesn);
-//   assert (bytes1 + ... + bytesn <= bytes);
-//   arena.swap ();
-//   ...
-//   if (!arena.contains (q)) delete q;
+//   p1 = arena.allocate (bytes1);
 //   ...
 //   arena.prepare (bytes);
-//   q1 = arena.copy (p1, bytes1);
+//   r1 = arena.copy (p1, bytes1);
 //   ...
-//   qn = arena.copy (pn, bytesn);
+//   rn = arena.copy (pn, bytesn);
 //   assert (bytes1 + ... + bytesn <= bytes);
 //   arena.swap ();
 //   ...
 //
-// One has to be really careful with 'qi' references to arena memory.
+// Before 'swap' the references 'ri' have to be resolved with 'relocated'.
 
+struct Clause;
 struct Internal;
 
 class Arena {
 
   Internal * internal;
 
-  struct { char * start, * top, * end; } from, to;
+  // A space is filled from 'start' to 'top'.  Memory up to 'end' can be
+  // used right away, while on Windows the rest of the reserved range up to
+  // 'limit' first has to be committed.
+
+  struct Space {
+    char * start, * top, * end, * limit;
+    vector<char *> outside;     // clauses allocated outside of the range
+  };
+
+  Space from, to;
+  char * moved;         // end of clauses moved to 'from' by last 'swap'
+  bool copying;         // between 'prepare' and 'swap'
+
+  static const unsigned outside_bit = 1u << 30;
+
+  void reserve (Space &, size_t wanted, size_t needed);
+  void unreserve (Space &);
+  bool commit (Space &, size_t bytes);
+  void release (Space &, char * p);
+  char * overflow (Space &, size_t bytes);
+
+  static unsigned reference (const Space & s, const char * p) {
+    if (s.start <= p && p < s.top) {
+      const size_t offset = p - s.start;
+      assert (!(offset & 7)), assert ((offset >> 3) < outside_bit);
+      return offset >> 3;
+    }
+    const size_t index = ((const size_t *) p)[-1];
+    assert (index < s.outside.size ()), assert (s.outside[index] == p);
+    return outside_bit | (unsigned) index;
+  }
+
+  static Clause * dereference (const Space & s, unsigned ref) {
+    if (ref & outside_bit) return (Clause *) s.outside[ref ^ outside_bit];
+    return (Clause *) (s.start + ((size_t) ref << 3));
+  }
 
 public:
 
   Arena (Internal *);
   ~Arena ();
 
+  // Allocate new memory in 'from' space.
+  //
+  char * allocate (size_t bytes) {
+    char * res = from.top;
+    if ((size_t) (from.end - res) < bytes) return overflow (from, bytes);
+    from.top += bytes;
+    return res;
+  }
+
   // Prepare 'to' space to hold that amount of memory.  Precondition is that
   // the 'to' space is empty.  The following sequence of 'copy' operations
-  // can use as much memory in sum as pre-allocated here.
+  // should use at most as much memory in sum as prepared here.
   //
   void prepare (size_t bytes);
 
-  // Does the memory pointed to by 'p' belong to this arena? More precisely
-  // to the 'from' space, since that is the only one remaining after 'swap'.
+  // Can that amount of memory be compacted in place in 'from' space,
+  // leaving enough room for new clauses?
+  //
+  bool fits (size_t bytes) const {
+    return from.outside.empty () &&
+      bytes <= (size_t) (from.limit - from.start) / 2;
+  }
+
+  // Was the memory pointed to by 'p' moved to 'from' by the last 'swap',
+  // in contrast to having been allocated afterwards?
   //
   bool contains (void * p) const {
     char * c = (char *) p;
-    return from.start <= c && c < from.top;
+    return from.start <= c && c < moved;
   }
 
-  // Allocate that amount of memory in 'to' space.  This assumes the 'to'
-  // space has been prepared to hold enough memory with 'prepare'.  Then
-  // copy the memory pointed to by 'p' of size 'bytes'.  Note that it does
-  // not matter whether 'p' is in 'from' or allocated outside of the arena.
+  // Allocate that amount of memory in 'to' space, which should have been
+  // prepared to hold enough memory with 'prepare'.  Then copy the memory
+  // pointed to by 'p' of size 'bytes' and return the reference of the copy.
   //
-  char * copy (const char * p, size_t bytes) {
+  unsigned copy (const char * p, size_t bytes) {
     char * res = to.top;
-    to.top += bytes;
-    assert (to.top <= to.end);
+    if ((size_t) (to.end - res) < bytes) res = overflow (to, bytes);
+    else to.top += bytes;
     memcpy (res, p, bytes);
-    return res;
+    return reference (to, res);
   }
 
-  // Completely delete 'from' space and then replace 'from' by 'to' (by
-  // pointer swapping).  Everything previously allocated (in 'from') and not
+  // Start of 'from' space, where clauses are compacted to in place if
+  // they are not localized by copying them to 'to' space.
+  //
+  char * bottom () const { return from.start; }
+
+  // After compacting clauses in place to end at 'top' give back the memory
+  // above to the operating system.  Clauses moved to 'from' by the last
+  // 'swap' now end at 'localized'.
+  //
+  void shrink (char * top, char * localized);
+
+  // Release the 'from' space and then replace 'from' by 'to' (by pointer
+  // swapping).  Everything previously allocated (in 'from') and not
   // explicitly copied to 'to' with 'copy' becomes invalid.
   //
   void swap ();
+
+  // 32-bit references of clauses in 'from' space.
+  //
+  unsigned reference (const Clause * c) const {
+    return reference (from, (const char *) c);
+  }
+
+  Clause * dereference (unsigned ref) const {
+    return dereference (from, ref);
+  }
+
+  // Resolve the reference of a clause moved by garbage collection, which is
+  // in 'to' space while copying and otherwise in 'from' space.
+  //
+  Clause * relocated (unsigned ref) const {
+    return dereference (copying ? to : from, ref);
+  }
 };
 
 }
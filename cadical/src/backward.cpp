@@ -69,7 +69,12 @@ void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
       if ((unsigned) d->size < size) continue;
       int negated = 0;
       unsigned found = 0;
-      for (const auto & lit : *d) {
+      const const_literal_iterator eod = d->end ();
+      for (const_literal_iterator l = d->begin (); l != eod; l++) {
+        // Abort as soon as not enough literals are left in 'd' to find
+        // all the remaining marked literals of 'c'.
+        if ((unsigned) (eod - l) < size - found) break;
+        const int lit = *l;
         signed char tmp = val (lit);
         if (tmp > 0) { satisfied = true; break; }
         if (tmp < 0) continue;
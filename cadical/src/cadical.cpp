@@ -3,6 +3,8 @@
 // Do include 'internal.hpp' but try to minimize internal dependencies.
 
 #include "internal.hpp"
+#include "conquer.hpp"
+#include "portfolio.hpp"
 #include "signal.hpp"           // Separate, only need for apps.
 
 /*------------------------------------------------------------------------*/
@@ -24,6 +26,8 @@ namespace CaDiCaL {
 class App : public Handler, public Terminator {
 
   Solver * solver;                // Global solver.
+  Portfolio * portfolio;          // Copies of 'solver' if '--threads'.
+  Conquer * conquer;              // Copies of 'solver' if '--cubes'.
 
 #ifndef __WIN32
   // Command line options.
@@ -42,6 +46,9 @@ class App : public Handler, public Terminator {
   //
   int force_strict_parsing;
 
+  int threads;                  // '--threads=<n>'
+  int cubes;                    // '--cubes=<depth>'
+
   bool force_writing;
   static bool most_likely_existing_cnf_file (const char * path);
 
@@ -115,6 +122,8 @@ void App::print_usage (bool all) {
 #ifndef __WIN32
 "  -t <sec>       set wall clock time limit\n"
 #endif
+"  --threads=<n>  solve with <n> threads sharing short learned clauses\n"
+"  --cubes=<d>    split into cubes of depth <d> solved by the threads\n"
     );
   } else {         // Print complete list of all options.
     printf (
@@ -130,6 +139,8 @@ void App::print_usage (bool all) {
 #ifndef __WIN32
 "  -t <sec>       set wall clock time limit\n"
 #endif
+"  --threads=<n>  solve with <n> threads sharing short learned clauses\n"
+"  --cubes=<d>    split into cubes of depth <d> solved by the threads\n"
 "\n"
 "Or '<option>' is one of the less common options\n"
 "\n"
@@ -253,6 +264,8 @@ void App::print_witness (FILE * file) {
   do {
     if (!c) fputc ('v', file), c = 1;
     if (i++ == max_var) tmp = 0;
+    else if (portfolio) tmp = portfolio->val (i) < 0 ? -i : i;
+    else if (conquer) tmp = conquer->val (i) < 0 ? -i : i;
     else tmp = solver->val (i) < 0 ? -i : i;
     char str[20];
     sprintf (str, " %d", tmp);
@@ -499,6 +512,12 @@ int App::main (int argc, char ** argv) {
       if (localsearch < 0)
         APPERR ("invalid argument in '%s' (expected non-negative number)",
           argv[i]);
+    } else if (has_prefix (argv[i], "--threads=")) {
+      if (!parse_int_str (argv[i] + 10, threads) || threads < 1)
+        APPERR ("invalid argument in '%s'", argv[i]);
+    } else if (has_prefix (argv[i], "--cubes=")) {
+      if (!parse_int_str (argv[i] + 8, cubes) || cubes < 1)
+        APPERR ("invalid argument in '%s'", argv[i]);
     } else if (has_prefix (argv[i], "--") &&
                solver->is_valid_configuration (argv[i] + 2)) {
       solver->configure (argv[i] + 2);
@@ -529,6 +548,8 @@ int App::main (int argc, char ** argv) {
       !strcmp (dimacs_path, proof_path) && strcmp (dimacs_path, "-"))
     APPERR ("DIMACS input file '%s' also specified as DRAT proof file",
       dimacs_path);
+  if ((threads > 1 || cubes) && proof_specified)
+    APPERR ("can not generate DRAT proofs with multiple threads");
 
   /*----------------------------------------------------------------------*/
   // The '--less' option is not fully functional yet (it is also not
@@ -777,6 +798,18 @@ int App::main (int argc, char ** argv) {
 
     if (inconclusive && res == 20)
       res = 0;
+  } else if (cubes) {
+    solver->section ("solving");
+    conquer = new Conquer (*solver, threads, cubes);
+    conquer->connect_terminator (this);
+    res = conquer->solve ();
+  } else if (threads > 1) {
+    solver->section ("solving");
+    solver->message ("portfolio of %d solvers", threads);
+    portfolio = new Portfolio (*solver, threads);
+    portfolio->connect_terminator (this);
+    res = portfolio->solve ();
+    solver->message ("answer found by solver %d", portfolio->solved_by ());
   } else {
     solver->section ("solving");
     res = solver->solve ();
@@ -824,7 +857,9 @@ int App::main (int argc, char ** argv) {
   fflush (write_result_file);
   if (write_result_path)
     fclose (write_result_file);
-  solver->statistics ();
+  if (portfolio) portfolio->statistics ();
+  else if (conquer) conquer->statistics ();
+  else solver->statistics ();
   solver->resources ();
   solver->section ("shutting down");
   solver->message ("exit %d", res);
@@ -852,6 +887,8 @@ void App::init () {
   time_limit = -1;
 #endif
   force_strict_parsing = 1;
+  threads = 1;
+  cubes = 0;
   force_writing = false;
   max_var = 0;
   timesup = false;
@@ -869,11 +906,14 @@ void App::init () {
 
 /*------------------------------------------------------------------------*/
 
-App::App () : solver (0) { }      // Only partially initialize the app.
+App::App () :                   // Only partially initialize.
+  solver (0), portfolio (0), conquer (0) { }
 
 App::~App () {
   if (!solver) return;            // Only partially initialized.
   Signal::reset ();
+  delete portfolio;
+  delete conquer;
   delete solver;
 }
 
@@ -193,6 +193,7 @@ struct External;
 // Forward declaration of call-back classes. See bottom of this file.
 
 class Learner;
+class Importer;
 class Terminator;
 class ClauseIterator;
 class WitnessIterator;
@@ -225,6 +226,15 @@ public:
   //
   void add (int lit);
 
+  // Add a whole clause of 'size' valid non zero literals at once, which is
+  // the same as calling 'add' for each literal followed by 'add (0)', but
+  // checks and updates the API state only once per clause.
+  //
+  //   require (VALID)                  // but no clause partially added
+  //   ensure (UNKNOWN)                 // unless adding a constraint
+  //
+  void clause (const int * lits, size_t size);
+
   // Assume valid non zero literal for next call to 'solve'.  These
   // assumptions are reset after the call to 'solve' as well as after
   // returning from 'simplify' and 'lookahead.
@@ -284,6 +294,15 @@ public:
   void connect_learner (Learner * learner);
   void disconnect_learner ();
 
+  // Connect an importer which is asked at restarts for clauses learned by
+  // other solvers on the same formula (see 'Importer' below).
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_importer (Importer * importer);
+  void disconnect_importer ();
+
   // ====== END IPASIR =====================================================
 
   //------------------------------------------------------------------------
@@ -515,6 +534,16 @@ public:
   int64_t redundant () const;   // Number of active redundant clauses.
   int64_t irredundant () const; // Number of active irredundant clauses.
 
+  // Current value of a statistics counter, one of 'conflicts', 'decisions',
+  // 'propagations' (summed over search, probing, vivification and the other
+  // propagating procedures), 'restarts', 'learned' (clauses), 'units',
+  // 'binaries', 'imported', 'fixed', 'eliminated', 'memory' and 'maxmemory'
+  // (resident set size in bytes).  Returns '-1' for unknown names.
+  //
+  //   require (VALID | SOLVING)
+  //
+  int64_t get_statistic_value (const char * name) const;
+
   //------------------------------------------------------------------------
   // This function executes the given number of preprocessing rounds. It is
   // similar to 'solve' with 'limits ("preprocessing", rounds)' except that
@@ -787,8 +816,10 @@ private:
   // the internal DIMACS parser.
 
   friend class App;
+  friend class Conquer;
   friend class Mobical;
   friend class Parser;
+  friend class Portfolio;
 
   // Read solution in competition format for debugging and testing.
   //
@@ -890,6 +921,19 @@ public:
   virtual void learn (int lit) = 0;
 };
 
+// Connected importers are asked at restarts for clauses to add as learned
+// clauses.  The 'import' function fills 'clause' with the next clause (in
+// external literals, without terminating zero) and returns false if there
+// is none.  Clauses must be implied by the formula, e.g., learned by another
+// solver on the same formula.  Clauses with variables which are not active
+// in this solver (eliminated, substituted or not used yet) are dropped.
+
+class Importer {
+public:
+  virtual ~Importer () { }
+  virtual bool import (std::vector<int> & clause) = 0;
+};
+
 /*------------------------------------------------------------------------*/
 
 // Allows to traverse all remaining irredundant clauses.  Satisfied and
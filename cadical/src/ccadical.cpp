@@ -1,10 +1,74 @@
 #include "cadical.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace CaDiCaL {
 
+// Termination conditions checked natively by the solver, which avoids
+// calling back into the host language from the search loop.  The deadline
+// is measured on a monotonic clock and the interrupt flag may be flipped
+// asynchronously by the host from any thread.
+
+struct NativeTerminator : Terminator {
+
+  typedef std::chrono::steady_clock clock;
+
+  std::atomic<bool> interrupted;
+  bool has_deadline;
+  clock::time_point deadline;
+
+  bool terminate () {
+    if (interrupted.load (std::memory_order_relaxed))
+      return true;
+    return has_deadline && clock::now () >= deadline;
+  }
+
+  void set_time_limit (double seconds) {
+    has_deadline = seconds > 0;
+    if (!has_deadline) return;
+    deadline = clock::now () +
+      std::chrono::duration_cast<clock::duration> (
+        std::chrono::duration<double> (seconds));
+  }
+
+  NativeTerminator () : interrupted (false), has_deadline (false) { }
+};
+
+// Literals handed over in fixed size segments of a ring, which a consumer
+// thread adds to the solver while the host fills the following segments.
+// Segments are acquired and submitted in ring order, 'count' being the
+// number of literals of a submitted segment, 'FREE' or 'FILLING' otherwise.
+
+struct Pipe {
+
+  enum { FREE = -1, FILLING = -2 };
+
+  int segments, size;
+  std::vector<int> ring, count;
+  int head, next;               // segment consumed next, acquired next
+  bool closing;
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::thread consumer;
+
+  Pipe (int n, int s) :
+    segments (n), size (s), ring ((size_t) n * s), count (n, FREE),
+    head (0), next (0), closing (false) { }
+
+  bool drained () const {
+    for (int c : count) if (c >= 0) return false;
+    return true;
+  }
+};
+
 struct Wrapper : Learner, Terminator {
 
   Solver * solver;
@@ -20,12 +84,28 @@ struct Wrapper : Learner, Terminator {
     void (*function) (void *, int *);
   } learner;
 
+  NativeTerminator native;
+
+  // Budgets applied to each 'solve' call (negative means unlimited).
+  //
+  int conflict_limit, decision_limit;
+
+  Pipe * pipe;
+
   bool terminate () {
+    if (native.terminate ())
+      return true;
     if (!terminator.function)
       return false;
     return terminator.function (terminator.state);
   }
 
+  int solve () {
+    if (conflict_limit >= 0) solver->limit ("conflicts", conflict_limit);
+    if (decision_limit >= 0) solver->limit ("decisions", decision_limit);
+    return solver->solve ();
+  }
+
   bool learning (int size) {
     if (!learner.function)
       return false;
@@ -48,12 +128,81 @@ struct Wrapper : Learner, Terminator {
     learner.end_clause = learner.begin_clause;
   }
 
-  Wrapper () : solver (new Solver ()) {
+  void consume () {
+    std::unique_lock<std::mutex> lock (pipe->mutex);
+    for (;;) {
+      pipe->changed.wait (lock, [this] {
+        return pipe->closing || pipe->count[pipe->head] >= 0; });
+      const int n = pipe->count[pipe->head];
+      if (n < 0) return;
+      const int * lits = &pipe->ring[(size_t) pipe->head * pipe->size];
+      lock.unlock ();
+      for (int i = 0; i < n; i++) solver->add (lits[i]);
+      lock.lock ();
+      pipe->count[pipe->head] = Pipe::FREE;
+      pipe->head = (pipe->head + 1) % pipe->segments;
+      pipe->changed.notify_all ();
+    }
+  }
+
+  int * open_pipe (int segments, int size) {
+    if (pipe) return pipe->ring.data ();
+    if (segments < 1 || size < 1) return 0;
+    pipe = new Pipe (segments, size);
+    pipe->consumer = std::thread (&Wrapper::consume, this);
+    return pipe->ring.data ();
+  }
+
+  int acquire () {
+    std::unique_lock<std::mutex> lock (pipe->mutex);
+    pipe->changed.wait (lock, [this] {
+      return pipe->count[pipe->next] == Pipe::FREE; });
+    const int segment = pipe->next;
+    pipe->count[segment] = Pipe::FILLING;
+    pipe->next = (pipe->next + 1) % pipe->segments;
+    return segment;
+  }
+
+  void submit (int segment, int count) {
+    std::lock_guard<std::mutex> lock (pipe->mutex);
+    pipe->count[segment] = count;
+    pipe->changed.notify_all ();
+  }
+
+  // Waits until the consumer has added every submitted literal, which has
+  // to happen before the solver is used from the calling thread.
+  //
+  void sync () {
+    if (!pipe) return;
+    std::unique_lock<std::mutex> lock (pipe->mutex);
+    pipe->changed.wait (lock, [this] { return pipe->drained (); });
+  }
+
+  void close_pipe () {
+    if (!pipe) return;
+    {
+      std::lock_guard<std::mutex> lock (pipe->mutex);
+      pipe->closing = true;
+      pipe->changed.notify_all ();
+    }
+    pipe->consumer.join ();
+    delete pipe;
+    pipe = 0;
+  }
+
+  Wrapper () :
+    solver (new Solver ()), conflict_limit (-1), decision_limit (-1),
+    pipe (0)
+  {
     memset (&terminator, 0, sizeof terminator);
     memset (&learner, 0, sizeof learner);
+    // Always connected, since the native conditions are cheap to check and
+    // the interrupt flag may be set while the solver is already running.
+    solver->connect_terminator (this);
   }
 
   ~Wrapper () {
+    close_pipe ();
     terminator.function = 0;
     if (learner.begin_clause) free (learner.begin_clause);
     delete solver; }
@@ -63,6 +212,14 @@ struct Wrapper : Learner, Terminator {
 
 using namespace CaDiCaL;
 
+// The solver of a wrapper, after the literals in its pipe have been added.
+
+static Solver * synced (void * ptr) {
+  Wrapper * wrapper = (Wrapper *) ptr;
+  wrapper->sync ();
+  return wrapper->solver;
+}
+
 extern "C" {
 
 #include "ccadical.h"
@@ -80,53 +237,58 @@ void ccadical_release (CCaDiCaL * wrapper) {
 }
 
 void ccadical_constrain (CCaDiCaL *wrapper, int lit){
-  ((Wrapper*) wrapper)->solver->constrain (lit);
+  synced (wrapper)->constrain (lit);
 }
 
 int ccadical_constraint_failed (CCaDiCaL * wrapper) {
-  return ((Wrapper*) wrapper)->solver->constraint_failed ();
+  return synced (wrapper)->constraint_failed ();
 }
 
 void ccadical_set_option (CCaDiCaL * wrapper,
                           const char * name, int val) {
-  ((Wrapper*) wrapper)->solver->set (name, val);
+  synced (wrapper)->set (name, val);
+}
+
+int ccadical_configure (CCaDiCaL * wrapper, const char * name) {
+  return synced (wrapper)->configure (name);
 }
 
 void ccadical_limit (CCaDiCaL * wrapper,
                      const char * name, int val) {
-  ((Wrapper*) wrapper)->solver->limit (name, val);
+  synced (wrapper)->limit (name, val);
 }
 
 int ccadical_get_option (CCaDiCaL * wrapper, const char * name) {
-  return ((Wrapper*) wrapper)->solver->get (name);
+  return synced (wrapper)->get (name);
 }
 
 void ccadical_add (CCaDiCaL * wrapper, int lit) {
-  ((Wrapper*) wrapper)->solver->add (lit);
+  synced (wrapper)->add (lit);
 }
 
 void ccadical_assume (CCaDiCaL * wrapper, int lit) {
-  ((Wrapper*) wrapper)->solver->assume (lit);
+  synced (wrapper)->assume (lit);
 }
 
 int ccadical_solve (CCaDiCaL * wrapper) {
-  return ((Wrapper*) wrapper)->solver->solve ();
+  ((Wrapper*) wrapper)->sync ();
+  return ((Wrapper*) wrapper)->solve ();
 }
 
 int ccadical_simplify (CCaDiCaL * wrapper) {
-  return ((Wrapper*) wrapper)->solver->simplify ();
+  return synced (wrapper)->simplify ();
 }
 
 int ccadical_val (CCaDiCaL * wrapper, int lit) {
-  return ((Wrapper*) wrapper)->solver->val (lit);
+  return synced (wrapper)->val (lit);
 }
 
 int ccadical_failed (CCaDiCaL * wrapper, int lit) {
-  return ((Wrapper*) wrapper)->solver->failed (lit);
+  return synced (wrapper)->failed (lit);
 }
 
 void ccadical_print_statistics (CCaDiCaL * wrapper) {
-  ((Wrapper*) wrapper)->solver->statistics ();
+  synced (wrapper)->statistics ();
 }
 
 void ccadical_terminate (CCaDiCaL * wrapper) {
@@ -134,15 +296,19 @@ void ccadical_terminate (CCaDiCaL * wrapper) {
 }
 
 int64_t ccadical_active (CCaDiCaL * wrapper) {
-  return ((Wrapper*) wrapper)->solver->active ();
+  return synced (wrapper)->active ();
+}
+
+int64_t ccadical_get_statistic (CCaDiCaL * wrapper, const char * name) {
+  return synced (wrapper)->get_statistic_value (name);
 }
 
 int64_t ccadical_irredundant (CCaDiCaL * wrapper) {
-  return ((Wrapper*) wrapper)->solver->irredundant ();
+  return synced (wrapper)->irredundant ();
 }
 
 int ccadical_fixed (CCaDiCaL * wrapper, int lit) {
-  return ((Wrapper*) wrapper)->solver->fixed (lit);
+  return synced (wrapper)->fixed (lit);
 }
 
 void ccadical_set_terminate (CCaDiCaL * ptr,
@@ -150,8 +316,22 @@ void ccadical_set_terminate (CCaDiCaL * ptr,
   Wrapper * wrapper = (Wrapper *) ptr;
   wrapper->terminator.state = state;
   wrapper->terminator.function = terminate;
-  if (terminate) wrapper->solver->connect_terminator (wrapper);
-  else wrapper->solver->disconnect_terminator ();
+}
+
+void ccadical_set_time_limit (CCaDiCaL * ptr, double seconds) {
+  ((Wrapper*) ptr)->native.set_time_limit (seconds);
+}
+
+void ccadical_set_conflict_limit (CCaDiCaL * ptr, int conflicts) {
+  ((Wrapper*) ptr)->conflict_limit = conflicts;
+}
+
+void ccadical_set_decision_limit (CCaDiCaL * ptr, int decisions) {
+  ((Wrapper*) ptr)->decision_limit = decisions;
+}
+
+void ccadical_set_interrupt (CCaDiCaL * ptr, int value) {
+  ((Wrapper*) ptr)->native.interrupted = (value != 0);
 }
 
 void ccadical_set_learn (CCaDiCaL * ptr,
@@ -161,20 +341,37 @@ void ccadical_set_learn (CCaDiCaL * ptr,
   wrapper->learner.state = state;
   wrapper->learner.max_length = max_length;
   wrapper->learner.function = learn;
+  wrapper->sync ();
   if (learn) wrapper->solver->connect_learner (wrapper);
   else wrapper->solver->disconnect_learner ();
 }
 
+int * ccadical_pipe_open (CCaDiCaL * ptr, int segments, int size) {
+  return ((Wrapper*) ptr)->open_pipe (segments, size);
+}
+
+int ccadical_pipe_acquire (CCaDiCaL * ptr) {
+  return ((Wrapper*) ptr)->acquire ();
+}
+
+void ccadical_pipe_submit (CCaDiCaL * ptr, int segment, int count) {
+  ((Wrapper*) ptr)->submit (segment, count);
+}
+
+void ccadical_pipe_flush (CCaDiCaL * ptr) {
+  ((Wrapper*) ptr)->sync ();
+}
+
 void ccadical_freeze (CCaDiCaL * ptr, int lit) {
-  ((Wrapper*) ptr)->solver->freeze (lit);
+  synced (ptr)->freeze (lit);
 }
 
 void ccadical_melt (CCaDiCaL * ptr, int lit) {
-  ((Wrapper*) ptr)->solver->melt (lit);
+  synced (ptr)->melt (lit);
 }
 
 int ccadical_frozen (CCaDiCaL * ptr, int lit) {
-  return ((Wrapper*) ptr)->solver->frozen (lit);
+  return synced (ptr)->frozen (lit);
 }
 
 }
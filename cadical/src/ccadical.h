@@ -36,11 +36,13 @@ void ccadical_set_learn (CCaDiCaL *,
 void ccadical_constrain (CCaDiCaL *, int lit);
 int ccadical_constraint_failed (CCaDiCaL *);
 void ccadical_set_option (CCaDiCaL *, const char * name, int val);
+int ccadical_configure (CCaDiCaL *, const char * name);
 void ccadical_limit (CCaDiCaL *, const char * name, int limit);
 int ccadical_get_option (CCaDiCaL *, const char * name);
 void ccadical_print_statistics (CCaDiCaL *);
 int64_t ccadical_active (CCaDiCaL *);
 int64_t ccadical_irredundant (CCaDiCaL *);
+int64_t ccadical_get_statistic (CCaDiCaL *, const char * name);
 int ccadical_fixed (CCaDiCaL *, int lit);
 void ccadical_terminate (CCaDiCaL *);
 void ccadical_freeze (CCaDiCaL *, int lit);
@@ -48,6 +50,29 @@ int ccadical_frozen (CCaDiCaL *, int lit);
 void ccadical_melt (CCaDiCaL *, int lit);
 int ccadical_simplify (CCaDiCaL *);
 
+// Native termination without calling back into the host.  The time limit
+// is a deadline 'seconds' from now on a monotonic clock (zero or negative
+// removes it), the conflict and decision limits apply to every following
+// 'ccadical_solve' call (negative means unlimited) and the interrupt flag
+// can be set and cleared asynchronously from another thread.
+
+void ccadical_set_time_limit (CCaDiCaL *, double seconds);
+void ccadical_set_conflict_limit (CCaDiCaL *, int conflicts);
+void ccadical_set_decision_limit (CCaDiCaL *, int decisions);
+void ccadical_set_interrupt (CCaDiCaL *, int value);
+
+// Pipelined clause addition.  'ccadical_pipe_open' allocates a ring of
+// 'segments' segments of 'size' literals and starts a thread adding the
+// submitted segments to the solver.  The host acquires the next segment,
+// writes literals (clauses may span segments) and submits it with the
+// number of literals written.  All other functions wait for the submitted
+// literals to be added first, 'ccadical_pipe_flush' only waits.
+
+int * ccadical_pipe_open (CCaDiCaL *, int segments, int size);
+int ccadical_pipe_acquire (CCaDiCaL *);
+void ccadical_pipe_submit (CCaDiCaL *, int segment, int count);
+void ccadical_pipe_flush (CCaDiCaL *);
+
 /*------------------------------------------------------------------------*/
 
 // Support legacy names used before moving to more IPASIR conforming names.
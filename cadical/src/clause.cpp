@@ -84,7 +84,7 @@ Clause * Internal::new_clause (bool red, int glue) {
   else keep = false;
 
   size_t bytes = Clause::bytes (size);
-  Clause * c = (Clause *) new char[bytes];
+  Clause * c = (Clause *) arena.allocate (bytes);
 
   stats.added.total++;
 #ifdef LOGGING
@@ -204,15 +204,13 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
   return res;
 }
 
-// This is the 'raw' deallocation of a clause.  If the clause is in the
-// arena nothing happens.  If the clause is not in the arena its memory is
-// reclaimed immediately.
+// This is the 'raw' deallocation of a clause.  All clauses are allocated
+// in the arena, where the memory of a deleted clause is only reclaimed by
+// the next garbage collection moving the remaining clauses.
 
 void Internal::deallocate_clause (Clause * c) {
-  char * p = (char*) c;
-  if (arena.contains (p)) return;
   LOG (c, "deallocate pointer %p", (void*) c);
-  delete [] p;
+  (void) c;
 }
 
 void Internal::delete_clause (Clause * c) {
@@ -82,20 +82,23 @@ struct Clause {
   int glue;
 
   int size;         // Actual size of 'literals' (at least 2).
-  int pos;          // Position of last watch replacement [Gent'13].
 
   union {
 
-    int literals[2];    // Of variadic 'size' (shrunken if strengthened).
+    int pos;            // Position of last watch replacement [Gent'13].
 
-    Clause * copy;      // Only valid if 'moved', then that's where to.
+    unsigned copy;      // Only valid if 'moved', then that's where to.
     //
-    // The 'copy' field is only valid for 'moved' clauses in the moving
-    // garbage collector 'copy_non_garbage_clauses' for keeping clauses
-    // compactly in a contiguous memory arena.  Otherwise, most of
-    // the time, 'literals' is valid.  See 'collect.cpp' for details.
+    // The 'copy' field is the arena reference of the new location of a
+    // 'moved' clause during garbage collection in 'collect.cpp'.  Since it
+    // does not overlay 'literals' the old location of a clause remains
+    // readable until all references to it have been updated, which is
+    // needed for compacting clauses in place.  Otherwise, most of the
+    // time, 'pos' is valid.
   };
 
+  int literals[2];      // Of variadic 'size' (shrunken if strengthened).
+
   literal_iterator       begin ()       { return literals; }
   literal_iterator         end ()       { return literals + size; }
 
@@ -146,7 +146,7 @@ size_t Internal::flush_occs (int lit) {
   for (i = j; i != end; i++) {
     c = *i;
     if (c->collect ()) continue;
-    *j++ = c->moved ? c->copy : c;
+    *j++ = c->moved ? arena.relocated (c->copy) : c;
     assert (!c->redundant);
     res++;
   }
@@ -159,30 +159,30 @@ size_t Internal::flush_occs (int lit) {
 // 'reduce' where we watch and no occurrence lists.  We have to protect
 // reason clauses not be collected and thus we have this additional check
 // hidden in 'Clause.collect', which for the root level context of
-// preprocessing is actually redundant.
-
-inline void Internal::flush_watches (int lit, Watches & saved) {
-  assert (saved.empty ());
-  Watches & ws = watches (lit);
-  const const_watch_iterator end = ws.end ();
-  watch_iterator j = ws.begin ();
-  const_watch_iterator i;
-  for (i = j; i != end; i++) {
-    Watch w = *i;
-    Clause * c = w.clause;
-    if (c->collect ()) continue;
-    if (c->moved) c = w.clause = c->copy;
-    w.size = c->size;
-    const int new_blit_pos = (c->literals[0] == lit);
-    assert (c->literals[!new_blit_pos] == lit);        /*FW1*/
-    w.blit = c->literals[new_blit_pos];
-    if (w.binary ()) *j++ = w;
-    else saved.push_back (w);
+// preprocessing is actually redundant.  Long clauses which have been
+// shrunken to binary clauses are moved to the binary watches.
+
+inline void Internal::flush_watches (int lit) {
+  Watches & bs = binaries (lit);
+  for (int binary = 1; binary >= 0; binary--) {
+    Watches & ws = binary ? bs : watches (lit);
+    const const_watch_iterator end = ws.end ();
+    watch_iterator j = ws.begin ();
+    const_watch_iterator i;
+    for (i = j; i != end; i++) {
+      Clause * c = watched (*i);
+      if (c->collect ()) continue;
+      const int new_blit_pos = (c->literals[0] == lit);
+      assert (c->literals[!new_blit_pos] == lit);        /*FW1*/
+      const int blit = c->literals[new_blit_pos];
+      const unsigned ref = c->moved ? c->copy : arena.reference (c);
+      const Watch w (blit, ref, c->size == 2);
+      if (binary || !w.binary ()) *j++ = w;
+      else bs.push_back (w);
+    }
+    ws.resize (j - ws.begin ());
+    shrink_vector (ws);
   }
-  ws.resize (j - ws.begin ());
-  for (const auto & w : saved) ws.push_back (w);
-  saved.clear ();
-  shrink_vector (ws);
 }
 
 void Internal::flush_all_occs_and_watches () {
@@ -190,11 +190,9 @@ void Internal::flush_all_occs_and_watches () {
     for (auto idx : vars)
       flush_occs (idx), flush_occs (-idx);
 
-  if (watching ()) {
-    Watches tmp;
+  if (watching ())
     for (auto idx : vars)
-      flush_watches (idx, tmp), flush_watches (-idx, tmp);
-  }
+      flush_watches (idx), flush_watches (-idx);
 }
 
 /*------------------------------------------------------------------------*/
@@ -210,7 +208,7 @@ void Internal::update_reason_references () {
     LOG (c, "updating assigned %d reason", lit);
     assert (c->reason);
     assert (c->moved);
-    Clause * d = c->copy;
+    Clause * d = arena.relocated (c->copy);
     v.reason = d;
     count++;
   }
@@ -219,35 +217,6 @@ void Internal::update_reason_references () {
 
 /*------------------------------------------------------------------------*/
 
-// This is a simple garbage collector which does not move clauses.  It needs
-// less space than the arena based clause allocator, but is not as cache
-// efficient, since the copying garbage collector can put clauses together
-// which are likely accessed after each other.
-
-void Internal::delete_garbage_clauses () {
-
-  flush_all_occs_and_watches ();
-
-  LOG ("deleting garbage clauses");
-  int64_t collected_bytes = 0, collected_clauses = 0;
-  const auto end = clauses.end ();
-  auto j = clauses.begin (), i = j;
-  while (i != end) {
-    Clause * c = *j++ = *i++;
-    if (!c->collect ()) continue;
-    collected_bytes += c->bytes ();
-    collected_clauses++;
-    delete_clause (c);
-    j--;
-  }
-  clauses.resize (j - clauses.begin ());
-  shrink_vector (clauses);
-
-  PHASE ("collect", stats.collections,
-    "collected %" PRId64 " bytes of %" PRId64 " garbage clauses",
-    collected_bytes, collected_clauses);
-}
-
 /*------------------------------------------------------------------------*/
 
 // This is the start of the copying garbage collector using the arena.  At
@@ -259,14 +228,58 @@ void Internal::copy_clause (Clause * c) {
   LOG (c, "moving");
   assert (!c->moved);
   char * p = (char*) c;
-  char * q = arena.copy (p, c->bytes ());
-  c->copy = (Clause *) q;
+  c->copy = arena.copy (p, c->bytes ());
   c->moved = true;
   LOG ("copied clause[%" PRId64 "] from %p to %p",
-       c->id, (void*) c, (void*) c->copy);
+       c->id, (void*) c, (void*) arena.relocated (c->copy));
+}
+
+// After all non garbage clauses have been given their new location ('copy'
+// of 'moved' clauses) references in watches, occurrence lists, reasons and
+// 'clauses' are updated and garbage clauses are deleted.  Old locations are
+// still readable at this point, since 'copy' does not overlay 'literals'.
+
+void Internal::update_clause_references () {
+
+  flush_all_occs_and_watches ();
+  update_reason_references ();
+
+  // Replace and flush clause references in 'clauses'.
+  //
+  const auto end = clauses.end ();
+  auto j = clauses.begin (), i = j;
+  for (; i != end; i++) {
+    Clause * c = *i;
+    if (c->collect ()) delete_clause (c);
+    else {
+      assert (c->moved);
+      *j++ = arena.relocated (c->copy);
+      deallocate_clause (c);
+    }
+  }
+  clauses.resize (j - clauses.begin ());
+  if (clauses.size () < clauses.capacity ()/2) shrink_vector (clauses);
+
+  if (opts.arenasort)
+    rsort (clauses.begin (), clauses.end (), pointer_rank ());
 }
 
-// This is the moving garbage collector.
+// Copy clauses watched by 'lit' in the order they are visited during
+// propagation, binary clauses first.
+
+inline void Internal::copy_watched_clauses (int lit) {
+  for (const auto & w : binaries (lit)) {
+    Clause * c = watched (w);
+    if (!c->moved && !c->collect ()) copy_clause (c);
+  }
+  for (const auto & w : watches (lit)) {
+    Clause * c = watched (w);
+    if (!c->moved && !c->collect ()) copy_clause (c);
+  }
+}
+
+// This is the moving garbage collector, which localizes clauses according
+// to the order in which they are watched.
 
 void Internal::copy_non_garbage_clauses () {
 
@@ -296,26 +309,7 @@ void Internal::copy_non_garbage_clauses () {
       if (!c->collect () && arena.contains (c))
         copy_clause (c);
 
-  if (opts.arenatype == 1 || !watching ()) {
-
-    // Localize according to current clause order.
-
-    // If the option 'opts.arenatype == 1' is set, then this means the
-    // solver uses the original order of clauses.  If there are no watches,
-    // we can not use the watched based copying policies below.  This
-    // happens if garbage collection is triggered during bounded variable
-    // elimination.
-
-    // Copy clauses according to the order of calling 'copy_clause', which
-    // in essence just gives a compacting garbage collector, since their
-    // relative order is kept, and actually already gives the largest
-    // benefit due to better cache locality.
-
-    for (const auto & c : clauses)
-      if (!c->moved && !c->collect ())
-        copy_clause (c);
-
-  } else if (opts.arenatype == 2) {
+  if (opts.arenatype == 2) {
 
     // Localize according to (original) variable order.
 
@@ -324,9 +318,7 @@ void Internal::copy_non_garbage_clauses () {
 
     for (int sign = -1; sign <= 1; sign += 2)
       for (auto idx : vars)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+        copy_watched_clauses (sign * likely_phase (idx));
 
   } else {
 
@@ -340,9 +332,7 @@ void Internal::copy_non_garbage_clauses () {
 
     for (int sign = -1; sign <= 1; sign += 2)
       for (int idx = queue.last; idx; idx = link (idx).prev)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+        copy_watched_clauses (sign * likely_phase (idx));
   }
 
   // Do not forget to move clauses which are not watched, which happened in
@@ -352,23 +342,7 @@ void Internal::copy_non_garbage_clauses () {
     if (!c->collect () && !c->moved)
       copy_clause (c);
 
-  flush_all_occs_and_watches ();
-  update_reason_references ();
-
-  // Replace and flush clause references in 'clauses'.
-  //
-  const auto end = clauses.end ();
-  auto j = clauses.begin (), i = j;
-  for (; i != end; i++) {
-    Clause * c = *i;
-    if (c->collect ()) delete_clause (c);
-    else assert (c->moved), *j++ = c->copy, deallocate_clause (c);
-  }
-  clauses.resize (j - clauses.begin ());
-  if (clauses.size () < clauses.capacity ()/2) shrink_vector (clauses);
-
-  if (opts.arenasort)
-    rsort (clauses.begin (), clauses.end (), pointer_rank ());
+  update_clause_references ();
 
   // Release 'from' space completely and then swap 'to' with 'from'.
   //
@@ -381,6 +355,87 @@ void Internal::copy_non_garbage_clauses () {
     collected_clauses);
 }
 
+// Without localization clauses keep their order in the arena, which allows
+// to slide them down in place.  This only touches the 'from' space and thus
+// avoids doubling the memory used by clauses during collection.  If the
+// 'clauses' are traversed in address order, then the new location of a
+// clause never overlaps a clause not moved yet.  The original clause
+// order is used as well if 'opts.arenatype == 1', in the first collection,
+// or if there are no watches, which happens if garbage collection is
+// triggered during bounded variable elimination.  Only if the 'from' space
+// became too small, or clauses had to be allocated outside of the arena,
+// the clauses are copied in the same order to a larger 'to' space.
+
+void Internal::compact_non_garbage_clauses () {
+
+  size_t collected_clauses = 0, collected_bytes = 0, moved_bytes = 0;
+
+  vector<Clause *> kept;
+  for (const auto & c : clauses)
+    if (!c->collect ()) kept.push_back (c), moved_bytes += c->bytes ();
+    else collected_bytes += c->bytes (), collected_clauses++;
+
+  rsort (kept.begin (), kept.end (), pointer_rank ());
+
+  const bool in_place = arena.fits (moved_bytes);
+
+  PHASE ("collect", stats.collections,
+    "%s %zd bytes %.0f%% of %zd non garbage clauses",
+    in_place ? "compacting" : "growing arena and moving",
+    moved_bytes,
+    percent (moved_bytes, collected_bytes + moved_bytes),
+    kept.size ());
+
+  if (in_place) {
+
+    // Assign new locations but save 'pos', which is overlaid by 'copy'.
+    //
+    vector<int> positions;
+    positions.reserve (kept.size ());
+    char * top = arena.bottom (), * localized = top;
+    for (const auto & c : kept) {
+      assert (!c->moved);
+      positions.push_back (c->pos);
+      c->copy = arena.reference ((Clause *) top);
+      c->moved = true;
+      top += c->bytes ();
+      if (arena.contains (c)) localized = top;
+    }
+    assert (moved_bytes == (size_t) (top - arena.bottom ()));
+
+    update_clause_references ();
+
+    auto p = positions.begin ();
+    for (const auto & c : kept) {
+      Clause * d = arena.relocated (c->copy);
+      assert ((char *) d <= (char *) c);
+      memmove (d, c, c->bytes ());
+      d->moved = false;
+      d->pos = *p++;
+    }
+    erase_vector (positions);
+
+    arena.shrink (top, localized);
+
+  } else {
+
+    arena.prepare (moved_bytes);
+    for (const auto & c : kept)
+      copy_clause (c);
+
+    update_clause_references ();
+    arena.swap ();
+  }
+
+  erase_vector (kept);
+
+  PHASE ("collect", stats.collections,
+    "collected %zd bytes %.0f%% of %zd garbage clauses",
+    collected_bytes,
+    percent (collected_bytes, collected_bytes + moved_bytes),
+    collected_clauses);
+}
+
 /*------------------------------------------------------------------------*/
 
 // Maintaining clause statistics is complex and error prone but necessary
@@ -410,6 +465,10 @@ bool Internal::arenaing () {
   return opts.arena && (stats.collections > 1);
 }
 
+bool Internal::localizing () {
+  return arenaing () && opts.arenatype > 1 && watching ();
+}
+
 void Internal::garbage_collection () {
   if (unsat) return;
   START (collect);
@@ -417,8 +476,8 @@ void Internal::garbage_collection () {
   stats.collections++;
   mark_satisfied_clauses_as_garbage ();
   if (!protected_reasons) protect_reasons ();
-  if (arenaing ()) copy_non_garbage_clauses ();
-  else delete_garbage_clauses ();
+  if (localizing ()) copy_non_garbage_clauses ();
+  else compact_non_garbage_clauses ();
   check_clause_stats ();
   check_var_stats ();
   unprotect_reasons ();
@@ -6,7 +6,12 @@ namespace CaDiCaL {
 
 // Compacting removes holes generated by inactive variables (fixed,
 // eliminated, substituted or pure) by mapping active variables indices down
-// to a contiguous interval of indices.
+// to a contiguous interval of indices.  By default the order of variables
+// is kept.  With 'opts.compactorder' variables are instead renumbered in
+// breadth-first search order over the irredundant clauses (Cuthill-McKee
+// or its reverse), such that variables occurring together in clauses get
+// close indices, and thus their entries in 'vals', 'vtab' etc. are more
+// likely to share cache lines during propagation and analysis.
 
 /*------------------------------------------------------------------------*/
 
@@ -23,6 +28,13 @@ bool Internal::compacting () {
 
 /*------------------------------------------------------------------------*/
 
+struct degree_smaller {
+  const vector<unsigned> & start;
+  degree_smaller (const vector<unsigned> & s) : start (s) { }
+  unsigned degree (int idx) const { return start[idx + 1] - start[idx]; }
+  bool operator () (int a, int b) const { return degree (a) < degree (b); }
+};
+
 struct Mapper {
 
   Internal * internal;
@@ -32,6 +44,7 @@ struct Mapper {
   int map_first_fixed;          // Mapped literal of first fixed variable.
   signed char first_fixed_val;  // Value of first fixed variable.
   size_t new_vsize;
+  bool permuted;                // Not monotone thus not mapped in place.
 
   /*----------------------------------------------------------------------*/
   // We produce a compacting garbage collector like map of old 'src' to
@@ -46,18 +59,31 @@ struct Mapper {
     new_max_var (0),
     first_fixed (0),
     map_first_fixed (0),
-    first_fixed_val (0)
+    first_fixed_val (0),
+    permuted (internal->opts.compactorder)
   {
     table = new int [ internal->max_var + 1u ];
     clear_n (table, internal->max_var + 1u);
 
     assert (!internal->level);
 
-    for (auto src : internal->vars) {
-      const Flags & f = internal->flags (src);
-      if (f.active ()) table[src] = ++new_max_var;
-      else if (f.fixed () && !first_fixed)
-        table[first_fixed = src] = map_first_fixed = ++new_max_var;
+    if (permuted) {
+      for (auto src : internal->vars)
+        if (internal->flags (src).fixed ()) {
+          table[first_fixed = src] = map_first_fixed = ++new_max_var;
+          break;
+        }
+      vector<int> order;
+      traverse (order);
+      for (auto src : order)
+        table[src] = ++new_max_var;
+    } else {
+      for (auto src : internal->vars) {
+        const Flags & f = internal->flags (src);
+        if (f.active ()) table[src] = ++new_max_var;
+        else if (f.fixed () && !first_fixed)
+          table[first_fixed = src] = map_first_fixed = ++new_max_var;
+      }
     }
 
     first_fixed_val = first_fixed ? internal->val (first_fixed) : 0;
@@ -66,6 +92,74 @@ struct Mapper {
 
   ~Mapper () { delete [] table; }
 
+  /*----------------------------------------------------------------------*/
+  // Breadth-first search over the clause graph of the active variables in
+  // the irredundant clauses.  Each connected component is started at an
+  // unvisited variable with the fewest occurrences as in Cuthill-McKee.
+  // Instead of visiting neighbouring variables, we visit all clauses of a
+  // variable and enqueue their unvisited variables, and mark clauses as
+  // visited, which keeps the search linear in the size of the formula.
+  // The occurrences are kept in a temporary compressed array 'occs' with
+  // the occurrences of 'idx' starting at 'start[idx]'.
+  //
+  void traverse (vector<int> & order) {
+
+    const int max_var = internal->max_var;
+    vector<Clause *> clauses;
+    vector<unsigned> start (max_var + 2u, 0);
+
+    for (const auto & c : internal->clauses) {
+      if (c->garbage || c->redundant) continue;
+      for (const auto & lit : *c)
+        start[abs (lit)]++;
+      clauses.push_back (c);
+    }
+
+    unsigned sum = 0;
+    for (int idx = 0; idx <= max_var + 1; idx++)
+      sum += start[idx], start[idx] = sum;
+
+    vector<unsigned> occs (sum);
+    for (unsigned i = 0; i < clauses.size (); i++)
+      for (const auto & lit : *clauses[i])
+        occs[--start[abs (lit)]] = i;
+
+    vector<int> candidates;
+    for (auto idx : internal->vars)
+      if (internal->flags (idx).active ())
+        candidates.push_back (idx);
+    stable_sort (candidates.begin (), candidates.end (),
+                 degree_smaller (start));
+
+    vector<bool> visited (max_var + 1u), done (clauses.size ());
+    order.reserve (candidates.size ());
+
+    for (auto root : candidates) {
+      if (visited[root]) continue;
+      visited[root] = true;
+      order.push_back (root);
+      for (size_t head = order.size () - 1; head < order.size (); head++) {
+        const int idx = order[head];
+        for (unsigned k = start[idx]; k != start[idx + 1]; k++) {
+          const unsigned i = occs[k];
+          if (done[i]) continue;
+          done[i] = true;
+          for (const auto & lit : *clauses[i]) {
+            const int other = abs (lit);
+            if (visited[other]) continue;
+            if (!internal->flags (other).active ()) continue;
+            visited[other] = true;
+            order.push_back (other);
+          }
+        }
+      }
+    }
+    assert (order.size () == candidates.size ());
+
+    if (internal->opts.compactorder > 1)
+      reverse (order.begin (), order.end ());
+  }
+
   /*----------------------------------------------------------------------*/
   // Map old variable indices.  A result of zero means not mapped.
   //
@@ -101,6 +195,16 @@ struct Mapper {
   //
   template<class T>
   void map_vector (vector<T> & v) {
+    if (permuted) {
+      vector<T> mapped (new_vsize);
+      mapped[0] = std::move (v[0]);
+      for (auto src : internal->vars) {
+        const int dst = map_idx (src);
+        if (dst) mapped[dst] = std::move (v[src]);
+      }
+      v.swap (mapped);
+      return;
+    }
     for (auto src : internal->vars) {
       const int dst = map_idx (src);
       if (!dst) continue;
@@ -117,6 +221,19 @@ struct Mapper {
   //
   template<class T>
   void map2_vector (vector<T> & v) {
+    if (permuted) {
+      vector<T> mapped (2*new_vsize);
+      mapped[0] = std::move (v[0]);
+      mapped[1] = std::move (v[1]);
+      for (auto src : internal->vars) {
+        const int dst = map_idx (src);
+        if (!dst) continue;
+        mapped[2*dst] = std::move (v[2*src]);
+        mapped[2*dst + 1] = std::move (v[2*src + 1]);
+      }
+      v.swap (mapped);
+      return;
+    }
     for (auto src : internal->vars) {
       const int dst = map_idx (src);
       if (!dst) continue;
@@ -139,7 +256,7 @@ struct Mapper {
     for (; i != end; i++) {
       const int src = *i;
       int dst = map_idx (abs (src));
-      assert (abs (dst) <= abs (src));
+      assert (permuted || abs (dst) <= abs (src));
       if (!dst) continue;
       if (src < 0) dst = -dst;
       *j++ = dst;
@@ -225,9 +342,12 @@ void Internal::compact () {
   // Map the blocking literals in all watches.
   //
   if (!wtab.empty ())
-    for (auto lit : lits)
+    for (auto lit : lits) {
+      for (auto & w : binaries (lit))
+        w.blit = mapper.map_lit (w.blit);
       for (auto & w : watches (lit))
         w.blit = mapper.map_lit (w.blit);
+    }
 
   // We first flush inactive variables and map the links in the queue.  This
   // has to be done before we map the actual links data structure 'links'.
@@ -281,16 +401,19 @@ void Internal::compact () {
 
   // Special code for 'frozentab'.
   //
-  for (auto src : vars) {
-    const int dst = mapper.map_idx (src);
-    if (!dst) continue;
-    if (src == dst) continue;
-    assert (dst < src);
-    frozentab[dst] += frozentab[src];
-    frozentab[src] = 0;
+  if (mapper.permuted) mapper.map_vector (frozentab);
+  else {
+    for (auto src : vars) {
+      const int dst = mapper.map_idx (src);
+      if (!dst) continue;
+      if (src == dst) continue;
+      assert (dst < src);
+      frozentab[dst] += frozentab[src];
+      frozentab[src] = 0;
+    }
+    frozentab.resize (mapper.new_vsize);
+    shrink_vector (frozentab);
   }
-  frozentab.resize (mapper.new_vsize);
-  shrink_vector (frozentab);
 
   /*----------------------------------------------------------------------*/
 
@@ -355,8 +478,10 @@ void Internal::compact () {
   mapper.map_vector (vtab);
   if (!ntab.empty ()) mapper.map2_vector (ntab);
   if (!wtab.empty ()) mapper.map2_vector (wtab);
+  if (!itab.empty ()) mapper.map2_vector (itab);
   if (!otab.empty ()) mapper.map2_vector (otab);
   if (!big.empty ()) mapper.map2_vector (big);
+  if (!sigtab.empty ()) mapper.map2_vector (sigtab);
 
   /*======================================================================*/
   // In the fourth part we map the binary heap for scores.
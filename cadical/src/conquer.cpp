@@ -0,0 +1,174 @@
+#include "internal.hpp"
+#include "conquer.hpp"
+
+#include <thread>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+struct Conquer::Worker : Terminator {
+
+  Conquer * conquer;
+  Solver * solver;
+  int id;
+  int64_t solved;                       // Cubes taken from the queue.
+
+  Worker (Conquer * c, int i) :
+    conquer (c), solver (new Solver), id (i), solved (0)
+  { }
+
+  ~Worker () { delete solver; }
+
+  bool terminate () {
+    if (conquer->done.load (std::memory_order_relaxed)) return true;
+    if (conquer->aborted.load (std::memory_order_relaxed)) return true;
+    return conquer->terminator && conquer->terminator->terminate ();
+  }
+
+  int solve (const std::vector<int> & cube, int limit) {
+    for (auto lit : cube)
+      solver->assume (lit);
+    if (limit >= 0) solver->limit ("conflicts", limit);
+    const int res = solver->solve ();
+    if (res == 10 && !conquer->done.exchange (true)) conquer->winner = id;
+    return res;
+  }
+
+  // A cube exceeding the conflict budget is split by lookahead under the
+  // cube as assumptions.  If lookahead does not provide a split the cube
+  // is solved without budget instead.
+
+  void run () {
+    std::vector<int> cube;
+    while (conquer->next (cube)) {
+      std::vector<std::vector<int>> split;
+      solved++;
+      int res = solve (cube, conquer->budget);
+      if (!res && !terminate ()) {
+        for (auto lit : cube)
+          solver->assume (lit);
+        auto cubes = solver->generate_cubes (1);
+        solver->reset_assumptions ();
+        if (!cubes.status && cubes.cubes.size () > 1)
+          split = std::move (cubes.cubes);
+        else res = solve (cube, -1);
+      }
+      if (!res && split.empty ()) conquer->aborted = true;
+      conquer->finished (res, split);
+    }
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+Conquer::Conquer (Solver & o, int threads, int d, int b) :
+  original (o), terminator (0), depth (d), budget (b), busy (0),
+  done (false), aborted (false), winner (-1),
+  generated (0), refuted (0), resplit (0)
+{
+  assert (threads > 0), assert (depth >= 0), assert (budget > 0);
+  for (int i = 0; i < threads; i++) {
+    Worker * w = new Worker (this, i);
+    original.copy (*w->solver);
+    if (i) w->solver->internal->opts.set ("quiet", 1);
+    w->solver->connect_terminator (w);
+    workers.push_back (w);
+  }
+}
+
+Conquer::~Conquer () {
+  for (auto w : workers)
+    delete w;
+}
+
+void Conquer::connect_terminator (Terminator * t) { terminator = t; }
+void Conquer::disconnect_terminator () { terminator = 0; }
+
+void Conquer::add (int lit) {
+  original.add (lit);
+  for (auto w : workers)
+    w->solver->add (lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Workers wait for cubes while others may still split theirs, and stop
+// if the queue is empty and no worker is busy anymore.
+
+bool Conquer::next (std::vector<int> & cube) {
+  std::unique_lock<std::mutex> lock (mutex);
+  wakeup.wait (lock, [this] () {
+    return done || aborted || !cubes.empty () || !busy;
+  });
+  if (done || aborted || cubes.empty ()) return false;
+  cube = std::move (cubes.front ());
+  cubes.pop_front ();
+  busy++;
+  return true;
+}
+
+void Conquer::finished (int res,
+                        const std::vector<std::vector<int>> & split) {
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    assert (busy > 0);
+    busy--;
+    if (res == 20) refuted++;
+    if (!split.empty ()) resplit++, generated += split.size ();
+    for (const auto & cube : split)
+      cubes.push_back (cube);
+  }
+  wakeup.notify_all ();
+}
+
+int Conquer::solve () {
+  done = aborted = false;
+  winner = -1;
+  cubes.clear ();
+  busy = 0;
+
+  // Lookahead may already decide the formula, in which case (as well as
+  // for no cubes at all) the workers solve the empty cube.
+  //
+  auto split = original.generate_cubes (depth);
+  if (split.status || split.cubes.empty ()) cubes.emplace_back ();
+  else for (auto & cube : split.cubes)
+    cubes.push_back (std::move (cube));
+  generated += cubes.size ();
+  original.message ("conquering %zd cubes of depth %d with %d threads",
+    cubes.size (), depth, threads ());
+
+  std::vector<std::thread> threads;
+  for (auto w : workers)
+    threads.emplace_back ([w] () { w->run (); });
+  for (auto & t : threads)
+    t.join ();
+
+  if (done) return 10;
+  if (aborted) return 0;
+  return 20;
+}
+
+int Conquer::val (int lit) {
+  assert (winner >= 0);
+  return workers[winner]->solver->val (lit);
+}
+
+void Conquer::statistics () {
+  original.section ("conquer");
+  original.message ("cubes:     %12" PRId64 " generated %10" PRId64
+    " refuted %10" PRId64 " split", generated, refuted, resplit);
+  for (auto w : workers)
+    original.message ("worker %2d: %12" PRId64 " cubes     %10" PRId64
+      " conflicts%s", w->id, w->solved,
+      w->solver->internal->stats.conflicts,
+      w->id == winner ? "  (model)" : "");
+  if (winner >= 0) {
+    Solver & s = *workers[winner]->solver;
+    s.set ("quiet", original.get ("quiet"));
+    s.statistics ();
+  }
+}
+
+}
@@ -0,0 +1,73 @@
+#ifndef _conquer_hpp_INCLUDED
+#define _conquer_hpp_INCLUDED
+
+#include "cadical.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace CaDiCaL {
+
+// Cube-and-conquer on top of 'generate_cubes'.  The original solver splits
+// the formula by lookahead into cubes up to the given 'depth', which are
+// put on a shared queue.  Each worker thread holds a copy of the original
+// solver and solves cubes from the queue incrementally under assumptions.
+// A cube which is not decided within 'budget' conflicts is split again by
+// lookahead in its worker and both halves go back to the queue.  The
+// formula is satisfiable as soon as one cube is, and unsatisfiable after
+// all cubes have been refuted.
+//
+// As with 'Portfolio' the copies are made with 'Solver::copy', thus the
+// original should not have been solved yet.
+
+class Conquer {
+
+  struct Worker;
+  std::vector<Worker *> workers;
+  Solver & original;
+  Terminator * terminator;     // External terminator if non-zero.
+  int depth, budget;
+
+  std::mutex mutex;            // Protects 'cubes' and 'busy'.
+  std::condition_variable wakeup;
+  std::deque<std::vector<int>> cubes;
+  int busy;                    // Workers currently solving a cube.
+
+  std::atomic<bool> done;      // Set by the first satisfiable cube.
+  std::atomic<bool> aborted;   // A cube was dropped due to termination.
+  int winner;
+
+  int64_t generated, refuted, resplit;
+
+  friend struct Worker;
+
+  bool next (std::vector<int> & cube);
+  void finished (int res, const std::vector<std::vector<int>> & split);
+
+public:
+
+  Conquer (Solver & original, int threads, int depth, int budget = 10000);
+  ~Conquer ();
+
+  int threads () const { return (int) workers.size (); }
+
+  void connect_terminator (Terminator *);
+  void disconnect_terminator ();
+
+  void add (int lit);           // Added to the original and all workers.
+  int solve ();                 // Same results as 'Solver::solve'.
+  int val (int lit);            // From the worker with the satisfied cube.
+
+  int solved_by () const { return winner; }
+
+  // Cubes generated, refuted and split again, cubes solved per worker and
+  // the statistics of the worker which found the model.
+  //
+  void statistics ();
+};
+
+}
+
+#endif
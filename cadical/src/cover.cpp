@@ -108,31 +108,38 @@ Internal::cover_propagate_asymmetric (int lit,
   assert (val (lit) < 0);
   bool subsumed = false;
   LOG ("asymmetric literal propagation of %d", lit);
+  for (const auto & w : binaries (lit)) {
+    const signed char b = val (w.blit);
+    if (b > 0) continue;
+    Clause * c = watched (w);
+    if (c == ignore || c->garbage) continue;
+    if (b < 0) {
+      LOG (c, "found subsuming");
+      return true;
+    }
+    asymmetric_literal_addition (-w.blit, coveror);
+  }
   Watches & ws = watches (lit);
   const const_watch_iterator eow = ws.end ();
   watch_iterator j = ws.begin ();
   const_watch_iterator i = j;
   while (!subsumed && i != eow) {
     const Watch w = *j++ = *i++;
-    if (w.clause == ignore) continue;   // costly but necessary here ...
+    Clause * c = watched (w);
+    if (c == ignore) continue;   // costly but necessary here ...
     const signed char b = val (w.blit);
     if (b > 0) continue;
-    if (w.clause->garbage) j--;
-    else if (w.binary ()) {
-      if (b < 0) {
-        LOG (w.clause, "found subsuming");
-        subsumed = true;
-      } else asymmetric_literal_addition (-w.blit, coveror);
-    } else {
-      literal_iterator lits = w.clause->begin ();
+    if (c->garbage) j--;
+    else {
+      literal_iterator lits = c->begin ();
       const int other = lits[0]^lits[1]^lit;
       lits[0] = other, lits[1] = lit;
       const signed char u = val (other);
       if (u > 0) j[-1].blit = other;
       else {
-        const int size = w.clause->size;
+        const int size = c->size;
         const const_literal_iterator end = lits + size;
-        const literal_iterator middle = lits + w.clause->pos;
+        const literal_iterator middle = lits + c->pos;
         literal_iterator k = middle;
         signed char v = -1;
         int r = 0;
@@ -140,25 +147,25 @@ Internal::cover_propagate_asymmetric (int lit,
           k++;
         if (v < 0) {
           k = lits + 2;
-          assert (w.clause->pos <= size);
+          assert (c->pos <= size);
           while (k != middle && (v = val (r = *k)) < 0)
             k++;
         }
-        w.clause->pos = k - lits;
-        assert (lits + 2 <= k), assert (k <= w.clause->end ());
+        c->pos = k - lits;
+        assert (lits + 2 <= k), assert (k <= c->end ());
         if (v > 0) j[-1].blit = r;
         else if (!v) {
-          LOG (w.clause, "unwatch %d in", lit);
+          LOG (c, "unwatch %d in", lit);
           lits[1] = r;
           *k = lit;
-          watch_literal (r, lit, w.clause);
+          watch_literal (r, lit, c);
           j--;
         } else if (!u) {
           assert (v < 0);
           asymmetric_literal_addition (-other, coveror);
         } else {
           assert (u < 0), assert (v < 0);
-          LOG (w.clause, "found subsuming");
+          LOG (c, "found subsuming");
           subsumed = true;
           break;
         }
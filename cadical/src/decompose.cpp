@@ -72,7 +72,7 @@ bool Internal::decompose_round () {
           // Go over all implied literals, thus need to iterate over all
           // binary watched clauses with the negation of 'parent'.
 
-          Watches & ws = watches (-parent);
+          Watches & ws = binaries (-parent);
 
           // Two cases: Either the node has never been visited before, i.e.,
           // it's depth first search index is zero, then perform the
@@ -91,7 +91,6 @@ bool Internal::decompose_round () {
             unsigned new_min = parent_dfs.min;
 
             for (const auto & w : ws) {
-              if (!w.binary ()) continue;
               const int child = w.blit;
               if (!active (child)) continue;
               const DFS & child_dfs = dfs[vlit (child)];
@@ -170,7 +169,6 @@ bool Internal::decompose_round () {
             // graph but keep 'parent' on the stack for 'post-fix' work.
 
             for (const auto & w : ws) {
-              if (!w.binary ()) continue;
               const int child = w.blit;
               if (!active (child)) continue;
               const DFS & child_dfs = dfs[vlit (child)];
@@ -33,7 +33,7 @@ inline double Internal::compute_elim_score (unsigned lit) {
 
 /*------------------------------------------------------------------------*/
 
-inline bool elim_more::operator () (unsigned a, unsigned b) {
+bool elim_more::operator () (unsigned a, unsigned b) {
   const auto s = internal->compute_elim_score (a);
   const auto t = internal->compute_elim_score (b);
   if (s > t) return true;
@@ -573,6 +573,16 @@ Internal::try_to_eliminate_variable (Eliminator & eliminator, int pivot) {
 
   if (pos) find_gate_clauses (eliminator, pivot);
 
+  eliminate_prepared_variable (eliminator, pivot);
+}
+
+// Second part of 'try_to_eliminate_variable' after occurrence lists of
+// 'pivot' are flushed and sorted and gate clauses are marked, which is
+// shared with parallel elimination in 'elimpar.cpp'.
+
+void
+Internal::eliminate_prepared_variable (Eliminator & eliminator, int pivot) {
+
   if (!unsat && !val (pivot)) {
     if (elim_resolvents_are_bounded (eliminator, pivot)) {
       LOG ("number of resolvents on %d are bounded", pivot);
@@ -718,17 +728,29 @@ int Internal::elim_round (bool & completed) {
 #ifndef QUIET
   int64_t tried = 0;
 #endif
+  // With 'elimthreads' larger than one the schedule is processed in batches
+  // of candidates with disjoint neighbourhoods whose resolvents are computed
+  // concurrently (see 'elimpar.cpp').
+  //
+  const bool parallel = opts.elimthreads > 1;
   while (!unsat &&
          !terminated_asynchronously () &&
          stats.elimres <= resolution_limit &&
          !schedule.empty ()) {
-    int idx = schedule.front ();
-    schedule.pop_front ();
-    flags (idx).elim = false;
-    try_to_eliminate_variable (eliminator, idx);
+    if (parallel) {
 #ifndef QUIET
-    tried++;
+      tried +=
 #endif
+      elim_parallel_batch (eliminator);
+    } else {
+      int idx = schedule.front ();
+      schedule.pop_front ();
+      flags (idx).elim = false;
+      try_to_eliminate_variable (eliminator, idx);
+#ifndef QUIET
+      tried++;
+#endif
+    }
     if (stats.garbage <= garbage_limit) continue;
     mark_redundant_clauses_with_eliminated_variables_as_garbage ();
     garbage_collection ();
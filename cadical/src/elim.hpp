@@ -15,12 +15,28 @@ struct elim_more {
 
 typedef heap<elim_more> ElimSchedule;
 
+// One candidate of a parallel elimination batch (see 'elimpar.cpp').  The
+// gate clauses are found before and the resolvents are computed on a worker
+// thread, then committed on the main thread.
+
+struct ElimJob {
+  int pivot;
+  bool bounded;                 // resolvents within bound and size limit
+  bool fallback;                // needs sequential 'resolve_clauses'
+  int64_t tried;                // number of tried resolutions
+  vector<Clause *> gates;       // gate clauses of 'pivot'
+  vector<int> resolvents;       // zero terminated resolvents
+  ElimJob (int p) :
+    pivot (p), bounded (false), fallback (false), tried (0) { }
+};
+
 struct Eliminator {
 
   Internal * internal;
   ElimSchedule schedule;
 
-  Eliminator (Internal * i) : internal (i), schedule (elim_more (i)) { }
+  Eliminator (Internal * i) :
+    internal (i), schedule (elim_more (i)), stamp (0) { }
   ~Eliminator ();
 
   queue<Clause*> backward;
@@ -30,6 +46,12 @@ struct Eliminator {
 
   vector<Clause *> gates;
   vector<int> marked;
+
+  // Only used for parallel elimination batches.
+  //
+  unsigned stamp;                       // current batch
+  vector<unsigned> stamps;              // batch of variable neighbourhood
+  vector<vector<signed char>> marks;    // resolution marks per worker
 };
 
 }
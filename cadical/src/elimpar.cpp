@@ -0,0 +1,292 @@
+#include "internal.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Parallel bounded variable elimination.  Candidates are taken from the
+// elimination schedule in batches.  A candidate is only added to a batch if
+// the variables occurring in its clauses (its neighbourhood) are disjoint
+// from the neighbourhoods of all the candidates already in the batch, which
+// is a greedy coloring of the occurrence graph restricted to the front of
+// the schedule.  Candidates overlapping with the batch are rescheduled.
+//
+// Flushing and sorting occurrence lists as well as finding gate clauses is
+// done sequentially while filling the batch.  Then the main work, i.e.,
+// checking the number of resolvents to be bounded and generating them, is
+// done concurrently on 'opts.elimthreads' worker threads, which only read
+// clauses, occurrence lists and values.  Finally the results are committed
+// sequentially in batch order, which thus also determines the order of
+// clauses pushed on the extension stack.  Since neighbourhoods are
+// disjoint, committing one candidate does not change the clauses of any
+// other candidate of the batch, except if new units are derived through
+// backward subsumption.  Then the remaining candidates fall back to the
+// sequential code as do candidates for which the worker found a satisfied
+// antecedent, a unit or empty resolvent or on-the-fly self-subsumption,
+// which all need to update the schedule or assign units.  The result does
+// not depend on the timing of threads and thus is deterministic.
+
+/*------------------------------------------------------------------------*/
+
+// Resolve 'c' and 'd' on 'pivot' on a worker thread and append the
+// resolvent followed by zero to 'resolvents'.  The result is positive if a
+// resolvent was added, zero if it is tautological and negative if the
+// sequential 'resolve_clauses' has to be used instead.  The signed
+// 'marks' (indexed by variables) are local to the worker.
+
+int Internal::resolve_clauses_concurrently (Clause * c, int pivot,
+                                            Clause * d,
+                                            vector<signed char> & marks,
+                                            vector<int> & resolvents) {
+
+  if (c->size > d->size) { pivot = -pivot; swap (c, d); }
+
+  const size_t start = resolvents.size ();
+  int s = 0, t = 0, res = 1;
+
+  for (const auto & lit : *c) {
+    if (lit == pivot) { s++; continue; }
+    const signed char tmp = val (lit);
+    if (tmp > 0) { res = -1; break; }
+    else if (tmp < 0) continue;
+    marks[abs (lit)] = sign (lit);
+    resolvents.push_back (lit);
+    s++;
+  }
+
+  if (res > 0) {
+    for (const auto & lit : *d) {
+      if (lit == -pivot) { t++; continue; }
+      const signed char tmp = val (lit);
+      if (tmp > 0) { res = -1; break; }
+      else if (tmp < 0) continue;
+      const signed char mark = marks[abs (lit)];
+      if (!mark) resolvents.push_back (lit), t++;
+      else if (mark == sign (lit)) t++;
+      else { res = 0; break; }
+    }
+  }
+
+  for (const auto & lit : *c)
+    marks[abs (lit)] = 0;
+
+  const int size = resolvents.size () - start;
+  if (res > 0 && (size < 2 || s > size || t > size)) res = -1;
+  if (res > 0) resolvents.push_back (0);
+  else resolvents.resize (start);
+
+  return res;
+}
+
+// Worker thread version of 'elim_resolvents_are_bounded' which also keeps
+// the resolvents instead of computing them again.
+
+void Internal::elim_resolve_job (ElimJob & job, vector<signed char> & marks)
+{
+  const int pivot = job.pivot;
+  const Occs & ps = occs (pivot);
+  const Occs & ns = occs (-pivot);
+  const int64_t pos = ps.size ();
+  const int64_t neg = ns.size ();
+  if (!pos || !neg) { job.bounded = lim.elimbound >= 0; return; }
+  const int64_t bound = pos + neg + lim.elimbound;
+  const bool substitute = !job.gates.empty ();
+
+  int64_t resolvents = 0;
+
+  for (const auto & c : ps) {
+    if (c->garbage) continue;
+    for (const auto & d : ns) {
+      if (d->garbage) continue;
+      if (substitute && c->gate == d->gate) continue;
+      job.tried++;
+      const size_t before = job.resolvents.size ();
+      const int tmp =
+        resolve_clauses_concurrently (c, pivot, d, marks, job.resolvents);
+      if (tmp < 0) { job.fallback = true; return; }
+      if (!tmp) continue;
+      const size_t size = job.resolvents.size () - before - 1;
+      if (size > (size_t) opts.elimclslim) return;
+      if (++resolvents > bound) return;
+    }
+  }
+
+  job.bounded = true;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Commit the resolvents computed by a worker (see 'elim_add_resolvents').
+
+void Internal::elim_add_job_resolvents (Eliminator & eliminator,
+                                        ElimJob & job) {
+  if (!job.gates.empty ()) {
+    LOG ("substituting pivot %d by resolving with %zd gate clauses",
+      job.pivot, job.gates.size ());
+    stats.elimsubst++;
+  }
+  LOG ("adding all resolvents on %d", job.pivot);
+  assert (clause.empty ());
+  int64_t resolvents = 0;
+  for (const auto & lit : job.resolvents) {
+    if (lit) { clause.push_back (lit); continue; }
+    Clause * r = new_resolved_irredundant_clause ();
+    elim_update_added_clause (eliminator, r);
+    eliminator.enqueue (r);
+    clause.clear ();
+    resolvents++;
+  }
+  erase_vector (job.resolvents);
+  LOG ("added %" PRId64 " resolvents to eliminate %d",
+    resolvents, job.pivot);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Fill, resolve and commit one batch and return the number of candidates
+// taken from the schedule and not rescheduled.
+
+int64_t Internal::elim_parallel_batch (Eliminator & eliminator) {
+
+  ElimSchedule & schedule = eliminator.schedule;
+  const size_t threads = opts.elimthreads;
+  const size_t max_jobs = 16 * threads;
+  const size_t max_popped = 4 * max_jobs;
+
+  if (eliminator.stamps.size () < vsize)
+    eliminator.stamps.resize (vsize, 0);
+  if (!++eliminator.stamp) {
+    fill (eliminator.stamps.begin (), eliminator.stamps.end (), 0);
+    eliminator.stamp = 1;
+  }
+  const unsigned stamp = eliminator.stamp;
+
+  vector<ElimJob> jobs;
+  vector<int> deferred, neighbours;
+  size_t popped = 0;
+
+  // Units derived while finding gates of later jobs might assign pivots
+  // or clauses of earlier jobs, which then are eliminated sequentially.
+  //
+  const size_t assigned = trail.size ();
+
+  while (!unsat &&
+         jobs.size () < max_jobs &&
+         popped < max_popped &&
+         !schedule.empty ()) {
+
+    const int idx = schedule.front ();
+    schedule.pop_front ();
+    flags (idx).elim = false;
+    popped++;
+
+    if (!active (idx)) continue;
+    assert (!frozen (idx));
+
+    int pivot = idx;
+    int64_t pos = flush_occs (pivot);
+    int64_t neg = flush_occs (-pivot);
+    if (pos > neg) { pivot = -pivot; swap (pos, neg); }
+    if (pos && neg > opts.elimocclim) {
+      LOG ("too many occurrences thus not eliminated %d", pivot);
+      continue;
+    }
+
+    // Collect the neighbourhood and check that it is disjoint.  Units
+    // derived while finding gates might reschedule a variable of the
+    // batch, which without occurrences does not show up as overlapping.
+    //
+    bool overlaps = (eliminator.stamps[idx] == stamp);
+    neighbours.clear ();
+    for (int sign = -1; !overlaps && sign <= 1; sign += 2) {
+      for (const auto & c : occs (sign * idx)) {
+        for (const auto & lit : *c) {
+          const int other = abs (lit);
+          if (eliminator.stamps[other] == stamp) { overlaps = true; break; }
+          neighbours.push_back (other);
+        }
+        if (overlaps) break;
+      }
+    }
+    if (overlaps) {
+      LOG ("neighbourhood of %d overlaps with batch", idx);
+      deferred.push_back (idx);
+      continue;
+    }
+
+    LOG ("trying to eliminate %d in parallel batch", pivot);
+    Occs & ps = occs (pivot);
+    stable_sort (ps.begin (), ps.end (), clause_smaller_size ());
+    Occs & ns = occs (-pivot);
+    stable_sort (ns.begin (), ns.end (), clause_smaller_size ());
+
+    if (pos) find_gate_clauses (eliminator, pivot);
+    if (unsat || val (pivot)) { unmark_gate_clauses (eliminator); continue; }
+
+    eliminator.stamps[idx] = stamp;
+    for (const auto & other : neighbours)
+      eliminator.stamps[other] = stamp;
+
+    jobs.push_back (ElimJob (pivot));
+    swap (jobs.back ().gates, eliminator.gates);
+  }
+
+  for (const auto & idx : deferred)
+    if (!schedule.contains (idx))
+      schedule.push_back (idx);
+
+  // Now let the workers check and generate resolvents.
+  //
+  if (!unsat && !jobs.empty ()) {
+    const size_t workers = min (threads, jobs.size ());
+    if (eliminator.marks.size () < workers)
+      eliminator.marks.resize (workers);
+    std::atomic<size_t> next (0);
+    auto work = [&] (size_t i) {
+      vector<signed char> & marks = eliminator.marks[i];
+      if (marks.size () < vsize) marks.resize (vsize, 0);
+      size_t j;
+      while ((j = next++) < jobs.size ())
+        elim_resolve_job (jobs[j], marks);
+    };
+    vector<std::thread> pool;
+    for (size_t i = 1; i < workers; i++)
+      pool.emplace_back (work, i);
+    work (0);
+    for (auto & thread : pool)
+      thread.join ();
+  }
+
+  // Finally commit all jobs in batch order.
+  //
+  for (auto & job : jobs) {
+    swap (eliminator.gates, job.gates);
+    const int pivot = job.pivot;
+    if (unsat) { unmark_gate_clauses (eliminator); continue; }
+    stats.elimres += job.tried;
+    if (job.fallback || trail.size () != assigned) {
+      LOG ("eliminating %d sequentially", pivot);
+      eliminate_prepared_variable (eliminator, pivot);
+      continue;
+    }
+    stats.elimtried++;
+    stats.elimrestried += job.tried;
+    if (job.bounded) {
+      LOG ("number of resolvents on %d are bounded", pivot);
+      assert (!val (pivot));
+      stats.elimres += job.tried;
+      elim_add_job_resolvents (eliminator, job);
+      if (!unsat) mark_eliminated_clauses_as_garbage (eliminator, pivot);
+      if (active (pivot)) mark_eliminated (pivot);
+    } else LOG ("too many resolvents on %d so not eliminated", pivot);
+    unmark_gate_clauses (eliminator);
+    elim_backward_clauses (eliminator);
+  }
+
+  return popped - deferred.size ();
+}
+
+}
@@ -10,6 +10,7 @@ External::External (Internal * i)
   extended (false),
   terminator (0),
   learner (0),
+  importer (0),
   solution (0),
   vars (max_var)
 {
@@ -292,10 +293,10 @@ CaDiCaL::CubesWithStatus External::generate_cubes (int depth, int min_depth = 0)
     MSG ("lookahead internal %d external %d", ilit, elit);
     return elit;
   };
-  auto externalize_map = [this, externalize](std::vector<int> cube) {
+  auto externalize_map = [this, externalize](std::vector<int> & cube) {
     (void) this;
     MSG("Cube : ");
-    std::for_each(begin(cube), end(cube), externalize);
+    std::transform(begin(cube), end(cube), begin(cube), externalize);
   };
   std::for_each(begin(cubes.cubes), end(cubes.cubes), externalize_map);
 
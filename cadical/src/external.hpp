@@ -87,6 +87,10 @@ struct External {
 
   Learner * learner;
 
+  // If there is an importer import clauses learned elsewhere at restarts.
+
+  Importer * importer;
+
   void export_learned_empty_clause ();
   void export_learned_unit_clause (int ilit);
   void export_learned_large_clause (const vector<int> &);
@@ -11,6 +11,9 @@ extern "C" {
 #include <sys/types.h>
 #include <unistd.h>
 #include <stdlib.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 }
 
 /*------------------------------------------------------------------------*/
@@ -21,7 +24,8 @@ namespace CaDiCaL {
 
 // Private constructor.
 
-File::File (Internal *i, bool w, int c, FILE * f, const char * n)
+File::File (Internal *i, bool w, int c, FILE * f, const char * n,
+            Zipper * z)
 :
 #ifndef QUIET
   internal (i),
@@ -30,10 +34,19 @@ File::File (Internal *i, bool w, int c, FILE * f, const char * n)
   writing (w),
 #endif
   close_file (c), file (f),
-  _name (n), _lineno (1), _bytes (0)
+  _name (n), _lineno (1), _bytes (0),
+  zipper (z), buffer (0), buffer_size (0),
+  map_begin (0), buf_pos (0), buf_end (0),
+  put_pos (0), put_end (0)
 {
   (void) i, (void) w;
   assert (f), assert (n);
+  if (!zipper) return;
+  assert (close_file == 3);
+  buffer_size = 1 << 22;
+  buffer = new char[buffer_size];
+  if (w) put_pos = buffer, put_end = buffer + buffer_size;
+  else buf_pos = buf_end = buffer;
 }
 
 /*------------------------------------------------------------------------*/
@@ -182,10 +195,15 @@ FILE * File::open_pipe (Internal * internal,
   return res;
 }
 
+// If the compression format is supported in-process, the compressed file
+// is opened directly and 'zipper' set instead of opening a pipe (unless
+// that fails).
+
 FILE * File::read_pipe (Internal * internal,
                         const char * fmt,
                         const int * sig,
-                        const char * path) {
+                        const char * path,
+                        Zipper * & zipper) {
   if (!File::exists (path)) {
     LOG ("file '%s' does not exist", path);
     return 0;
@@ -193,18 +211,113 @@ FILE * File::read_pipe (Internal * internal,
   LOG ("file '%s' exists", path);
   if (sig && !File::match (internal, path, sig)) return 0;
   LOG ("file '%s' matches signature for '%s'", path, fmt);
+  if (Zipper::supports (path)) {
+    FILE * res = read_file (internal, path);
+    if (res && (zipper = Zipper::open (res, path, false))) {
+      MSG ("decompressing '%s' in-process", path);
+      return res;
+    }
+    if (res) fclose (res);
+  }
   MSG ("opening pipe to read '%s'", path);
   return open_pipe (internal, fmt, path, "r");
 }
 
 FILE * File::write_pipe (Internal * internal,
-                         const char * fmt, const char * path) {
+                         const char * fmt, const char * path,
+                         Zipper * & zipper) {
+  if (Zipper::supports (path)) {
+    FILE * res = write_file (internal, path);
+    if (res && (zipper = Zipper::open (res, path, true))) {
+      MSG ("compressing '%s' in-process", path);
+      return res;
+    }
+    if (res) fclose (res);
+  }
   MSG ("opening pipe to write '%s'", path);
   return open_pipe (internal, fmt, path, "w");
 }
 
 /*------------------------------------------------------------------------*/
 
+// Map a regular file opened for reading into memory.  Then 'get' and the
+// parser read from memory directly without going through 'getc'.
+
+bool File::map (Internal * internal) {
+#ifdef QUIET
+  (void) internal;
+#endif
+#ifndef _WIN32
+  assert (!writing), assert (!map_begin), assert (!zipper);
+  struct stat buf;
+  const int fd = fileno (file);
+  if (fstat (fd, &buf)) return false;
+  if (!S_ISREG (buf.st_mode) || buf.st_size <= 0) return false;
+  const size_t bytes = buf.st_size;
+  void * ptr = mmap (0, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (ptr == MAP_FAILED) {
+    MSG ("could not memory map '%s'", name ());
+    return false;
+  }
+  madvise (ptr, bytes, MADV_SEQUENTIAL);
+  map_begin = buf_pos = (const char *) ptr;
+  buf_end = map_begin + bytes;
+  MSG ("memory mapped %zd bytes of '%s'", bytes, name ());
+  return true;
+#else
+  return false;
+#endif
+}
+
+void File::unmap () {
+#ifndef _WIN32
+  if (!map_begin) return;
+  munmap ((void *) map_begin, buf_end - map_begin);
+  map_begin = buf_pos = buf_end = 0;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+// Move the characters not read yet to the start of the buffer (which is
+// enlarged if they fill more than half of it) and decompress more.
+
+bool File::fill () {
+  assert (!writing), assert (buf_pos);
+  if (!zipper) return false;
+  const size_t kept = buf_end - buf_pos;
+  if (2*kept > buffer_size) {
+    char * enlarged = new char[2*buffer_size];
+    memcpy (enlarged, buf_pos, kept);
+    delete [] buffer;
+    buffer = enlarged;
+    buffer_size *= 2;
+  } else memmove (buffer, buf_pos, kept);
+  const long res = zipper->read (buffer + kept, buffer_size - kept);
+  buf_pos = buffer;
+  buf_end = buffer + kept;
+  if (res > 0) { buf_end += res; return true; }
+  if (res < 0) {
+#ifndef QUIET
+    WARNING ("failed to decompress '%s'", name ());
+#endif
+    delete zipper;
+    zipper = 0;
+  }
+  return false;
+}
+
+// Hand the buffered characters to in-process compression.
+
+bool File::flush_buffer () {
+  assert (writing), assert (zipper), assert (put_pos);
+  const size_t bytes = put_pos - buffer;
+  put_pos = buffer;
+  return zipper->write (buffer, bytes);
+}
+
+/*------------------------------------------------------------------------*/
+
 File * File::read (Internal * internal, FILE * f, const char * n) {
   return new File (internal, false, 0, f, n);
 }
@@ -215,21 +328,23 @@ File * File::write (Internal * internal, FILE * f, const char * n) {
 
 File * File::read (Internal * internal, const char * path) {
   FILE * file;
+  Zipper * zipper = 0;
   int close_input = 2;
   if (has_suffix (path, ".xz")) {
-    file = read_pipe (internal, "xz -c -d %s", xzsig, path);
+    file = read_pipe (internal, "xz -c -d %s", xzsig, path, zipper);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".lzma")) {
-    file = read_pipe (internal, "lzma -c -d %s", lzmasig, path);
+    file = read_pipe (internal, "lzma -c -d %s", lzmasig, path, zipper);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".bz2")) {
-    file = read_pipe (internal, "bzip2 -c -d %s", bz2sig, path);
+    file = read_pipe (internal, "bzip2 -c -d %s", bz2sig, path, zipper);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".gz")) {
-    file = read_pipe (internal, "gzip -c -d %s", gzsig, path);
+    file = read_pipe (internal, "gzip -c -d %s", gzsig, path, zipper);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".7z")) {
-    file = read_pipe (internal, "7z x -so %s 2>/dev/null", sig7z, path);
+    file = read_pipe (internal, "7z x -so %s 2>/dev/null",
+                      sig7z, path, zipper);
     if (!file) goto READ_FILE;
   } else {
 READ_FILE:
@@ -237,25 +352,33 @@ READ_FILE:
     close_input = 1;
   }
 
-  return file ? new File (internal, false, close_input, file, path) : 0;
+  if (!file) return 0;
+  if (zipper) close_input = 3;
+  File * res = new File (internal, false, close_input, file, path, zipper);
+  if (close_input == 1) res->map (internal);
+  return res;
 }
 
 File * File::write (Internal * internal, const char * path) {
   FILE * file;
+  Zipper * zipper = 0;
   int close_input = 2;
   if (has_suffix (path, ".xz"))
-    file = write_pipe (internal, "xz -c > %s", path);
+    file = write_pipe (internal, "xz -c > %s", path, zipper);
   else if (has_suffix (path, ".bz2"))
-    file = write_pipe (internal, "bzip2 -c > %s", path);
+    file = write_pipe (internal, "bzip2 -c > %s", path, zipper);
   else if (has_suffix (path, ".gz"))
-    file = write_pipe (internal, "gzip -c > %s", path);
+    file = write_pipe (internal, "gzip -c > %s", path, zipper);
   else if (has_suffix (path, ".7z"))
     file = write_pipe (internal,
-                       "7z a -an -txz -si -so > %s 2>/dev/null", path);
+                       "7z a -an -txz -si -so > %s 2>/dev/null",
+                       path, zipper);
   else
     file = write_file (internal, path), close_input = 1;
 
-  return file ? new File (internal, true, close_input, file, path) : 0;
+  if (!file) return 0;
+  if (zipper) close_input = 3;
+  return new File (internal, true, close_input, file, path, zipper);
 }
 
 void File::close () {
@@ -265,12 +388,27 @@ void File::close () {
   }
   if (close_file == 1) {
     MSG ("closing file '%s'", name ());
+    unmap ();
     fclose (file);
   }
   if (close_file == 2) {
     MSG ("closing pipe command on '%s'", name ());
     pclose (file);
   }
+  if (close_file == 3) {
+    MSG ("closing zipped file '%s'", name ());
+    if (put_pos && zipper && (!flush_buffer () || !zipper->finish ())) {
+#ifndef QUIET
+      WARNING ("failed to compress '%s'", name ());
+#endif
+    }
+    delete zipper;
+    zipper = 0;
+    delete [] buffer;
+    buffer = put_pos = put_end = 0;
+    buf_pos = buf_end = 0;
+    fclose (file);
+  }
 
   file = 0;     // mark as closed
 
@@ -281,7 +419,7 @@ void File::close () {
     MSG ("after writing %" PRIu64 " bytes %.1f MB", bytes (), mb);
   else
     MSG ("after reading %" PRIu64 " bytes %.1f MB", bytes (), mb);
-  if (close_file == 2) {
+  if (close_file >= 2) {
     int64_t s = size (name ());
     double mb = s / (double) (1<<20);
     if (writing)
@@ -298,6 +436,7 @@ void File::close () {
 
 void File::flush () {
   assert (file);
+  if (put_pos && zipper) flush_buffer ();
   fflush (file);
 }
 
@@ -22,11 +22,16 @@
 namespace CaDiCaL {
 
 // Wraps a 'C' file 'FILE' with name and supports zipped reading and writing
-// through 'popen' using external helper tools.  Reading has line numbers.
-// Compression and decompression relies on external utilities, e.g., 'gzip',
-// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.
+// either in-process (see 'zipper.hpp') or otherwise through 'popen' using
+// external helper tools.  Reading has line numbers.  Compression and
+// decompression through pipes relies on external utilities, e.g., 'gzip',
+// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.  Regular files
+// opened for reading by path are memory mapped if possible and in-process
+// decompression produces large blocks of characters, which in both cases
+// allows the parser to scan them directly (see 'parse_dimacs_buffered').
 
 struct Internal;
+class Zipper;
 
 class File {
 
@@ -37,13 +42,29 @@ class File {
   bool writing;
 #endif
 
-  int close_file;       // need to close file (1=fclose, 2=pclose)
+  int close_file;       // need to close file (1=fclose, 2=pclose, 3=zipped)
   FILE * file;
   const char * _name;
   uint64_t _lineno;
   uint64_t _bytes;
 
-  File (Internal *, bool, int, FILE *, const char *);
+  Zipper * zipper;              // in-process (de)compression (if non-zero)
+  char * buffer;                // block of uncompressed characters
+  size_t buffer_size;
+
+  const char * map_begin;       // memory mapped file (if non-zero)
+  const char * buf_pos;         // next character to read from memory
+  const char * buf_end;         // end of characters in memory
+
+  char * put_pos;               // next character to compress
+  char * put_end;
+
+  File (Internal *, bool, int, FILE *, const char *, Zipper * = 0);
+
+  bool map (Internal *);
+  void unmap ();
+
+  bool flush_buffer ();
 
   static FILE * open_file (Internal *,
                            const char * path, const char * mode);
@@ -57,9 +78,11 @@ class File {
   static FILE * read_pipe (Internal *,
                            const char * fmt,
                            const int * sig,
-                           const char * path);
+                           const char * path,
+                           Zipper * &);
   static FILE * write_pipe (Internal *,
-                            const char * fmt, const char * path);
+                            const char * fmt, const char * path,
+                            Zipper * &);
 public:
 
   static char* find (const char * prg);    // search in 'PATH'
@@ -93,7 +116,10 @@ public:
 
   int get () {
     assert (!writing);
-    int res = cadical_getc_unlocked (file);
+    int res;
+    if (!buf_pos) res = cadical_getc_unlocked (file);
+    else if (buf_pos == buf_end && !fill ()) res = EOF;
+    else res = (unsigned char) *buf_pos++;
     if (res == '\n') _lineno++;
     if (res != EOF) _bytes++;
     return res;
@@ -101,17 +127,15 @@ public:
 
   bool put (char ch) {
     assert (writing);
-    if (cadical_putc_unlocked (ch, file) == EOF) return false;
+    if (put_pos) {
+      if (put_pos == put_end && !flush_buffer ()) return false;
+      *put_pos++ = ch;
+    } else if (cadical_putc_unlocked (ch, file) == EOF) return false;
     _bytes++;
     return true;
   }
 
-  bool put (unsigned char ch) {
-    assert (writing);
-    if (cadical_putc_unlocked (ch, file) == EOF) return false;
-    _bytes++;
-    return true;
-  }
+  bool put (unsigned char ch) { return put ((char) ch); }
 
   bool put (const char * s) {
     for (const char * p = s; *p; p++)
@@ -163,6 +187,26 @@ public:
     }
   }
 
+  // Direct access to the characters in memory of a memory mapped file or a
+  // decompressed block.  After scanning them 'advance' skips to 'p' and
+  // updates line numbers.  Then 'fill' keeps the remaining characters and
+  // appends the next decompressed ones.  It returns 'false' if there are no
+  // more characters (and always for memory mapped files).
+  //
+  bool buffered () const { return buf_pos; }
+  const char * position () const { return buf_pos; }
+  const char * end () const { return buf_end; }
+  bool fill ();
+
+  void advance (const char * p) {
+    assert (buffered ());
+    assert (buf_pos <= p), assert (p <= buf_end);
+    for (const char * q = buf_pos; q != p; q++)
+      if (*q == '\n') _lineno++;
+    _bytes += p - buf_pos;
+    buf_pos = p;
+  }
+
   const char * name () const { return _name; }
   uint64_t lineno () const { return _lineno; }
   uint64_t bytes () const { return _bytes; }
@@ -0,0 +1,69 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+// Clauses learned by other solvers on the same formula, e.g., by the other
+// workers of a 'Portfolio', are imported at restarts.  They are implied by
+// the formula, thus can be added as redundant clauses, as long as all their
+// variables are still active here.  A variable eliminated or substituted in
+// this solver does not occur in its clauses anymore, and adding a clause
+// with such a variable would break the reconstruction of the solution.
+// Importing requires the root level, as literals fixed there are removed
+// (and satisfied clauses dropped) before the clause is watched.
+
+void Internal::import_clauses () {
+  assert (external->importer);
+  if (unsat) return;
+  if (proof) return;    // Imported clauses can not be justified in proofs.
+  vector<int> eclause;
+  while (!unsat) {
+    eclause.clear ();
+    if (!external->importer->import (eclause)) break;
+    assert (clause.empty ());
+    bool skip = false;
+    for (const auto & elit : eclause) {
+      const int eidx = abs (elit);
+      int ilit = eidx <= external->max_var ? external->e2i[eidx] : 0;
+      if (!ilit) { skip = true; break; }
+      if (elit < 0) ilit = -ilit;
+      const Flags & f = flags (ilit);
+      if (f.status == Flags::FIXED) {
+        if (val (ilit) > 0) { skip = true; break; }
+        continue;
+      }
+      if (!f.active ()) {
+        stats.imported.dropped++;
+        skip = true;
+        break;
+      }
+      const int tmp = marked (ilit);
+      if (tmp < 0) { skip = true; break; }    // tautological
+      if (tmp > 0) continue;                  // duplicated
+      mark (ilit);
+      clause.push_back (ilit);
+    }
+    for (const auto & lit : clause)
+      unmark (lit);
+    if (skip) { clause.clear (); continue; }
+    if (level) backtrack ();
+    LOG (clause, "importing");
+    stats.imported.clauses++;
+    const size_t size = clause.size ();
+#ifndef NDEBUG
+    // On the root level all assigned literals are fixed, thus removed.
+    for (const auto & lit : clause)
+      assert (!val (lit));
+#endif
+    if (!size) learn_empty_clause ();
+    else if (size == 1) {
+      stats.imported.units++;
+      assign_unit (clause[0]);
+    } else {
+      Clause * c = new_clause (true, (int) size - 1);
+      watch_clause (c);
+    }
+    clause.clear ();
+  }
+}
+
+}
@@ -36,6 +36,7 @@ Internal::Internal ()
   proof (0),
   checker (0),
   tracer (0),
+  walkthread (0),
   opts (this),
 #ifndef QUIET
   profiles (this),
@@ -53,6 +54,7 @@ Internal::Internal ()
 }
 
 Internal::~Internal () {
+  if (walkthread) stop_walk_thread ();
   for (const auto & c : clauses)
     delete_clause (c);
   if (proof) delete proof;
@@ -123,6 +125,7 @@ void Internal::enlarge (int new_max_var) {
   LOG ("enlarge internal size from %zd to new size %zd", vsize, new_vsize);
   // Ordered in the size of allocated memory (larger block first).
   enlarge_only (wtab, 2*new_vsize);
+  enlarge_only (itab, 2*new_vsize);
   enlarge_only (vtab, new_vsize);
   enlarge_zero (parents, new_vsize);
   enlarge_only (links, new_vsize);
@@ -204,6 +207,8 @@ int Internal::cdcl_loop_with_inprocessing () {
     else if (search_limits_hit ()) break;    // decision or conflict limit
     else if (terminated_asynchronously ())    // externally terminated
       break;
+    else if (walkthread && walk_thread_found_model ())
+      res = walk_thread_model ();            // found by local search
     else if (restarting ()) restart ();      // restart by backtracking
     else if (rephasing ()) rephase ();       // reset variable phases
     else if (reducing ()) reduce ();         // collect useless clauses
@@ -595,6 +600,7 @@ int Internal::solve (bool preprocess_only) {
   if (!preprocess_only) {
     if (!res) res = local_search ();
     if (!res) res = lucky_phases ();
+    if (!res && opts.walkthread) start_walk_thread ();
     if (!res) res = cdcl_loop_with_inprocessing ();
   }
   reset_solving ();
@@ -627,6 +633,7 @@ void Internal::report_solving (int res) {
 }
 
 void Internal::reset_solving () {
+  if (walkthread) stop_walk_thread ();
   if (termination_forced) {
 
     // TODO this leads potentially to a data race if the external
@@ -83,6 +83,7 @@ extern "C" {
 #include "reluctant.hpp"
 #include "resources.hpp"
 #include "score.hpp"
+#include "signature.hpp"
 #include "stats.hpp"
 #include "terminal.hpp"
 #include "tracer.hpp"
@@ -91,6 +92,7 @@ extern "C" {
 #include "version.hpp"
 #include "vivify.hpp"
 #include "watch.hpp"
+#include "zipper.hpp"
 
 /*------------------------------------------------------------------------*/
 
@@ -101,6 +103,7 @@ using namespace std;
 struct Coveror;
 struct External;
 struct Walker;
+struct WalkThread;
 
 struct CubesWithStatus {
   int status;
@@ -176,7 +179,9 @@ struct Internal {
   vector<int> ptab;             // table for caching probing attempts
   vector<int64_t> ntab;         // number of one-sided occurrences table
   vector<Bins> big;             // binary implication graph
+  vector<Sigs> sigtab;          // signatures of clauses in 'occs'
   vector<Watches> wtab;         // table of watches for all literals
+  vector<Watches> itab;         // table of binary watches for all literals
   Clause * conflict;            // set in 'propagation', reset in 'analyze'
   Clause * ignore;              // ignored during 'vivify_propagate'
   size_t propagated;            // next trail position to propagate
@@ -207,13 +212,14 @@ struct Internal {
   Proof * proof;                // clausal proof observers if non zero
   Checker * checker;            // online proof checker observing proof
   Tracer * tracer;              // proof to file tracer observing proof
+  WalkThread * walkthread;      // concurrent local search if non zero
   Options opts;                 // run-time options
   Stats stats;                  // statistics
 #ifndef QUIET
   Profiles profiles;            // time profiles for various functions
   bool force_phase_messages;    // force 'phase (...)' messages
 #endif
-  Arena arena;                  // memory arena for moving garbage collector
+  Arena arena;                  // memory arena holding all clauses
   Format error_message;         // provide persistent error message
   string prefix;                // verbose messages prefix
 
@@ -333,9 +339,11 @@ struct Internal {
   bool watching () const      { return !wtab.empty (); }
 
   Bins & bins (int lit)       { return big[vlit (lit)]; }
+  Sigs & sigs (int lit)       { return sigtab[vlit (lit)]; }
   Occs & occs (int lit)       { return otab[vlit (lit)]; }
   int64_t & noccs (int lit)   { return ntab[vlit (lit)]; }
   Watches & watches (int lit) { return wtab[vlit (lit)]; }
+  Watches & binaries (int lit) { return itab[vlit (lit)]; }
 
   // Variable bumping through exponential VSIDS (EVSIDS) as in MiniSAT.
   //
@@ -440,16 +448,25 @@ struct Internal {
   void unmark_clause ();        // unmark 'this->clause'
   void unmark (Clause *);
 
-  // Watch literal 'lit' in clause with blocking literal 'blit'.
+  // Watch literal 'lit' in clause with blocking literal 'blit'.  Binary
+  // clauses are watched in their own lists of 'binaries' and the blocking
+  // literal of a binary watch is always the other literal of the clause.
   // Inlined here, since it occurs in the tight inner loop of 'propagate'.
   //
   inline void watch_literal (int lit, int blit, Clause * c) {
     assert (lit != blit);
-    Watches & ws = watches (lit);
-    ws.push_back (Watch (blit, c));
+    const bool binary = (c->size == 2);
+    Watches & ws = binary ? binaries (lit) : watches (lit);
+    ws.push_back (Watch (blit, arena.reference (c), binary));
     LOG (c, "watch %d blit %d in", lit, blit);
   }
 
+  // The clause of a watch in the arena.
+  //
+  Clause * watched (const Watch & w) const {
+    return arena.dereference (w.reference ());
+  }
+
   // Add two watches to a clause.  This is used initially during allocation
   // of a clause and during connecting back all watches after preprocessing.
   //
@@ -463,8 +480,14 @@ struct Internal {
   inline void unwatch_clause (Clause * c) {
     const int l0 = c->literals[0];
     const int l1 = c->literals[1];
-    remove_watch (watches (l0), c);
-    remove_watch (watches (l1), c);
+    const unsigned ref = arena.reference (c);
+    if (c->size == 2) {
+      remove_watch (binaries (l0), ref);
+      remove_watch (binaries (l1), ref);
+    } else {
+      remove_watch (watches (l0), ref);
+      remove_watch (watches (l1), ref);
+    }
   }
 
   // Update queue to point to last potentially still unassigned variable.
@@ -524,11 +547,16 @@ struct Internal {
 
   // Forward reasoning through propagation in 'propagate.cpp'.
   //
+  // The templates are specialized on 'opts.chrono' and whether we are
+  // 'searching_lucky_phases' and selected once per call to 'propagate'.
+  //
   int assignment_level (int lit, Clause*);
+  template<int chrono, bool lucky> void search_assign (int lit, Clause *);
   void search_assign (int lit, Clause *);
   void search_assign_driving (int lit, Clause * reason);
   void search_assume_decision (int decision);
   void assign_unit (int lit);
+  template<int chrono, bool lucky> bool propagate ();
   bool propagate ();
 
   // Undo and restart in 'backtrack.cpp'.
@@ -575,6 +603,10 @@ struct Internal {
   int reuse_trail ();
   void restart ();
 
+  // Importing clauses learned by other solvers in 'import.cpp'.
+  //
+  void import_clauses ();
+
   // Functions to set and reset certain 'phases'.
   //
   void clear_phases (vector<signed char> &);  // reset argument to zero
@@ -636,15 +668,18 @@ struct Internal {
   void remove_falsified_literals (Clause *);
   void mark_satisfied_clauses_as_garbage ();
   void copy_clause (Clause *);
-  void flush_watches (int lit, Watches &);
+  void copy_watched_clauses (int lit);
+  void flush_watches (int lit);
   size_t flush_occs (int lit);
   void flush_all_occs_and_watches ();
   void update_reason_references ();
+  void update_clause_references ();
   void copy_non_garbage_clauses ();
-  void delete_garbage_clauses ();
+  void compact_non_garbage_clauses ();
   void check_clause_stats ();
   void check_var_stats ();
   bool arenaing ();
+  bool localizing ();
   void garbage_collection ();
 
   // Set-up occurrence list counters and containers.
@@ -652,15 +687,16 @@ struct Internal {
   void init_occs ();
   void init_bins ();
   void init_noccs ();
+  void init_sigs ();
   void reset_occs ();
   void reset_bins ();
+  void reset_sigs ();
   void reset_noccs ();
 
   // Operators on watches.
   //
   void init_watches ();
   void connect_watches (bool irredundant_only = false);
-  void sort_watches ();
   void clear_watches ();
   void reset_watches ();
 
@@ -864,11 +900,21 @@ struct Internal {
     void elim_backward_clauses(Eliminator &);
     void elim_propagate(Eliminator &, int unit);
     void elim_on_the_fly_self_subsumption(Eliminator &, Clause *, int);
+    void eliminate_prepared_variable(Eliminator &, int pivot);
     void try_to_eliminate_variable(Eliminator &, int pivot);
     void increase_elimination_bound();
     int elim_round(bool &completed);
     void elim(bool update_limits = true);
 
+    // Parallel bounded variable elimination in 'elimpar.cpp'.
+    //
+    int resolve_clauses_concurrently(Clause *, int pivot, Clause *,
+                                     vector<signed char> & marks,
+                                     vector<int> & resolvents);
+    void elim_resolve_job(ElimJob &, vector<signed char> & marks);
+    void elim_add_job_resolvents(Eliminator &, ElimJob &);
+    int64_t elim_parallel_batch(Eliminator &);
+
     void inst_assign(int lit);
     bool inst_propagate();
     void collect_instantiation_candidates(Instantiator &);
@@ -909,6 +955,7 @@ struct Internal {
 
     // ProbSAT/WalkSAT implementation called initially or from 'rephase'.
     //
+    void walk_watch_literal(int lit, int blit, Clause *);
     void walk_save_minimum(Walker &);
     Clause *walk_pick_clause(Walker &);
     unsigned walk_break_value(int lit);
@@ -917,6 +964,14 @@ struct Internal {
     int walk_round(int64_t limit, bool prev);
     void walk();
 
+    // Local search running concurrently to CDCL on its own thread.
+    //
+    void start_walk_thread();
+    void import_walk_phases();
+    bool walk_thread_found_model();
+    int walk_thread_model();
+    void stop_walk_thread();
+
     // Detect strongly connected components in the binary implication graph
     // (BIG) and equivalent literal substitution (ELS) in 'decompose.cpp'.
     //
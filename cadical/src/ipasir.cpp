@@ -51,4 +51,48 @@ void ipasir_set_learn (void * solver,
   ccadical_set_learn ((CCaDiCaL*) solver, state, max_length, learn);
 }
 
+void ipasir_set_time_limit (void * solver, double seconds) {
+  ccadical_set_time_limit ((CCaDiCaL*) solver, seconds);
+}
+
+void ipasir_set_conflict_limit (void * solver, int conflicts) {
+  ccadical_set_conflict_limit ((CCaDiCaL*) solver, conflicts);
+}
+
+void ipasir_set_decision_limit (void * solver, int decisions) {
+  ccadical_set_decision_limit ((CCaDiCaL*) solver, decisions);
+}
+
+void ipasir_set_interrupt (void * solver, int value) {
+  ccadical_set_interrupt ((CCaDiCaL*) solver, value);
+}
+
+int ipasir_configure (void * solver, const char * name) {
+  return ccadical_configure ((CCaDiCaL*) solver, name);
+}
+
+void ipasir_set_option (void * solver, const char * name, int val) {
+  ccadical_set_option ((CCaDiCaL*) solver, name, val);
+}
+
+int64_t ipasir_get_statistic (void * solver, const char * name) {
+  return ccadical_get_statistic ((CCaDiCaL*) solver, name);
+}
+
+int * ipasir_pipe_open (void * solver, int segments, int size) {
+  return ccadical_pipe_open ((CCaDiCaL*) solver, segments, size);
+}
+
+int ipasir_pipe_acquire (void * solver) {
+  return ccadical_pipe_acquire ((CCaDiCaL*) solver);
+}
+
+void ipasir_pipe_submit (void * solver, int segment, int count) {
+  ccadical_pipe_submit ((CCaDiCaL*) solver, segment, count);
+}
+
+void ipasir_pipe_flush (void * solver) {
+  ccadical_pipe_flush ((CCaDiCaL*) solver);
+}
+
 }
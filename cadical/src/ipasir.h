@@ -7,6 +7,8 @@ extern "C" {
 #endif
 /*------------------------------------------------------------------------*/
 
+#include <stdint.h>
+
 // Here are the declarations for the actual IPASIR functions, which is the
 // generic incremental reentrant SAT solver API used for instance in the SAT
 // competition.  The other 'C' API in 'ccadical.h' is (more) type safe and
@@ -30,6 +32,35 @@ void ipasir_set_learn (void * solver,
                        void * state, int max_length,
 		       void (*learn)(void * state, int * clause));
 
+// Non-IPASIR extensions forwarding to the corresponding 'ccadical_...'
+// functions, which terminate 'ipasir_solve' without the overhead of calling
+// back through 'ipasir_set_terminate'.
+
+void ipasir_set_time_limit (void * solver, double seconds);
+void ipasir_set_conflict_limit (void * solver, int conflicts);
+void ipasir_set_decision_limit (void * solver, int decisions);
+void ipasir_set_interrupt (void * solver, int value);
+
+// Option presets ('sat', 'unsat', 'plain', see 'cadical --configurations')
+// and single options, to be set before any clause is added.  Returns zero
+// for an unknown preset.
+
+int ipasir_configure (void * solver, const char * name);
+void ipasir_set_option (void * solver, const char * name, int val);
+
+// Statistics counter of the solver (see 'Solver::get_statistic_value'),
+// '-1' for unknown names.
+
+int64_t ipasir_get_statistic (void * solver, const char * name);
+
+// Pipelined clause addition through a ring of segments drained by a thread
+// of the library (see 'ccadical_pipe_open').
+
+int * ipasir_pipe_open (void * solver, int segments, int size);
+int ipasir_pipe_acquire (void * solver);
+void ipasir_pipe_submit (void * solver, int segment, int count);
+void ipasir_pipe_flush (void * solver);
+
 /*------------------------------------------------------------------------*/
 #ifdef __cplusplus
 }
@@ -364,7 +364,7 @@ int Internal::lookahead_probing() {
       MSG ("propagating units after probing results in empty clause");
       learn_empty_clause ();
       res = INT_MIN;
-    } else sort_watches ();
+    }
   }
 
 #ifndef QUIET
@@ -390,6 +390,7 @@ int Internal::lookahead_probing() {
 CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
   if (!active() || depth == 0) {
     CubesWithStatus cubes;
+    cubes.status = 0;
     cubes.cubes.push_back(std::vector<int>());
     return cubes;
   }
@@ -35,4 +35,22 @@ void Internal::reset_noccs () {
   LOG ("reset two-sided occurrence counters");
 }
 
+/*------------------------------------------------------------------------*/
+
+// Clause signatures kept in parallel to the one-watch occurrence lists in
+// 'subsume' (see 'signature.hpp').
+
+void Internal::init_sigs () {
+  assert (sigtab.empty ());
+  if (sigtab.size () < 2*vsize)
+    sigtab.resize (2*vsize, Sigs ());
+  LOG ("initialized clause signature lists");
+}
+
+void Internal::reset_sigs () {
+  assert (!sigtab.empty ());
+  erase_vector (sigtab);
+  LOG ("reset clause signature lists");
+}
+
 }
@@ -1,5 +1,12 @@
 #include "internal.hpp"
 
+#include <functional>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 namespace CaDiCaL {
@@ -78,6 +85,201 @@ Parser::parse_lit (int & ch, int & lit, int & vars, int strict) {
 
 /*------------------------------------------------------------------------*/
 
+// Parsing the body of a 'p bcnf <vars> <clauses>' file, written by caches
+// of encoded instances.  As in binary DRAT proofs, a literal 'lit' is given
+// as the unsigned number '2*abs(lit) + (lit < 0)' in 7-bit little endian
+// chunks, with the highest bit set on all but the last byte, and a zero
+// byte terminates a clause.  This avoids parsing decimal numbers and white
+// space, which dominates the time to read large text files.
+
+const char * Parser::parse_bcnf (int & vars, int clauses, int strict) {
+  int ch, lit = 0, parsed = 0;
+  while ((ch = parse_char ()) != EOF) {
+    uint64_t code = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+      if (shift > 28) PER ("binary literal too large");
+      code |= (uint64_t) (ch & 0x7f) << shift;
+      if (!(ch & 0x80)) break;
+      if ((ch = parse_char ()) == EOF)
+        PER ("unexpected end-of-file in binary literal");
+    }
+    if (code == 1 || (code >> 1) > (uint64_t) INT_MAX)
+      PER ("invalid binary literal");
+    const int idx = code >> 1;
+    lit = (code & 1) ? -idx : idx;
+    if (idx > vars) {
+      if (strict != FORCED)
+        PER ("literal %d exceeds maximum variable %d", lit, vars);
+      else vars = idx;
+    }
+    solver->add (lit);
+    if (!lit && parsed++ >= clauses && strict != FORCED)
+      PER ("too many clauses");
+  }
+  if (lit) PER ("last clause without terminating '0'");
+  if (parsed < clauses && strict != FORCED) PER ("clause missing");
+  MSG ("parsed %d binary clauses", parsed);
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Fast path for parsing the body of a DIMACS file which is memory mapped
+// or decompressed in-process into large blocks of characters.  Complete
+// lines of the characters in memory are split into chunks at new-lines.
+// Each chunk is scanned into a vector of literals, concurrently if
+// 'opts.parsethreads' is larger than one, and then the clauses are added
+// in order as a whole.  Then the file keeps the characters after the last
+// added clause and decompresses more.  This only covers well-formed input.
+// At the first anomaly (including too many clauses and too large
+// variables) the file is set back to the start of the first clause not
+// added yet and the remaining characters are parsed character by character
+// by the generic code, which then produces the proper parse error message
+// (with the right line number).
+
+struct ParseChunk {
+  const char * begin, * end;    // lines in memory
+  const char * last;            // after last parsed '0' (or zero)
+  vector<int> literals;         // parsed literals including zeros
+  int64_t zeros;                // number of parsed clauses
+  int max_var;                  // maximum variable index
+  bool failed;                  // found anomaly
+};
+
+// Find the end of a sequence of digits (16 characters at a time if SSE2
+// is available).
+
+static inline const char * scan_digits (const char * p, const char * end)
+{
+#if defined(__SSE2__)
+  const __m128i lower = _mm_set1_epi8 ('0' - 1);
+  const __m128i upper = _mm_set1_epi8 ('9' + 1);
+  while (end - p >= 16) {
+    const __m128i v = _mm_loadu_si128 ((const __m128i *) p);
+    const __m128i digits =
+      _mm_and_si128 (_mm_cmpgt_epi8 (v, lower), _mm_cmplt_epi8 (v, upper));
+    const unsigned others = ~_mm_movemask_epi8 (digits) & 0xffff;
+    if (others) return p + __builtin_ctz (others);
+    p += 16;
+  }
+#endif
+  while (p != end && isdigit ((unsigned char) *p)) p++;
+  return p;
+}
+
+// Scan a literal starting at 'p' followed by white space or a comment as
+// accepted by 'parse_lit' and return where to continue or zero if this is
+// not possible.
+
+static inline const char *
+scan_lit (const char * p, const char * end, int & lit) {
+  int sign = 1;
+  if (*p == '-') sign = -1, p++;
+  const char * q = scan_digits (p, end);
+  if (q == p || q - p > 10) return 0;
+  int64_t res = 0;
+  while (p != q) res = 10*res + (*p++ - '0');
+  if (res > INT_MAX) return 0;
+  lit = sign * (int) res;
+  if (q != end && *q == '\r') q++;
+  if (q == end) return q;
+  const char ch = *q++;
+  if (ch == ' ' || ch == '\t' || ch == '\n') return q;
+  if (ch != 'c') return 0;
+  q = (const char *) memchr (q, '\n', end - q);
+  return q ? q + 1 : 0;
+}
+
+static void parse_chunk (ParseChunk & chunk, int vars, bool forced) {
+  const char * p = chunk.begin, * end = chunk.end;
+  while (p != end) {
+    const char ch = *p;
+    if (ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r') {
+      p++;
+      continue;
+    }
+    if (ch == 'c') {
+      p = (const char *) memchr (p, '\n', end - p);
+      if (!p) break;
+      p++;
+      continue;
+    }
+    int lit;
+    p = scan_lit (p, end, lit);
+    if (!p) { chunk.failed = true; break; }
+    const int idx = abs (lit);
+    if (idx > vars && !forced) { chunk.failed = true; break; }
+    if (idx > chunk.max_var) chunk.max_var = idx;
+    chunk.literals.push_back (lit);
+    if (!lit) chunk.zeros++, chunk.last = p;
+  }
+}
+
+void Parser::parse_dimacs_buffered (int & vars, int clauses, int strict,
+                                    int & parsed) {
+  assert (file->buffered ());
+  const size_t threads = internal->opts.parsethreads;
+  const size_t chunk_bytes = 1 << 22;
+  const bool forced = (strict == FORCED);
+  vector<ParseChunk> chunks (threads);
+  vector<int> clause;
+  bool done = false, more = true;
+  for (;;) {
+    const char * p = file->position (), * end = file->end ();
+    const char * restart = p;   // after last added clause
+    if (more)                   // only complete lines unless at the end
+      while (end != p && end[-1] != '\n')
+        end--;
+    while (!done && p != end) {
+      size_t n = 0;
+      while (n < threads && p != end) {
+        ParseChunk & chunk = chunks[n++];
+        chunk.begin = p;
+        if ((size_t) (end - p) <= chunk_bytes) p = end;
+        else {
+          p = (const char *) memchr (p + chunk_bytes, '\n',
+                                     end - p - chunk_bytes);
+          p = p ? p + 1 : end;
+        }
+        chunk.end = p;
+        chunk.last = 0;
+        chunk.literals.clear ();
+        chunk.zeros = 0;
+        chunk.max_var = 0;
+        chunk.failed = false;
+      }
+      vector<std::thread> workers;
+      for (size_t i = 1; i < n; i++)
+        workers.emplace_back (parse_chunk,
+                              std::ref (chunks[i]), vars, forced);
+      parse_chunk (chunks[0], vars, forced);
+      for (auto & worker : workers)
+        worker.join ();
+      for (size_t i = 0; !done && i < n; i++) {
+        ParseChunk & chunk = chunks[i];
+        if (chunk.failed) done = true;
+        else if (!forced && parsed + chunk.zeros > clauses) done = true;
+        if (done) break;
+        if (chunk.max_var > vars) vars = chunk.max_var;
+        for (const auto & lit : chunk.literals)
+          if (lit) clause.push_back (lit);
+          else {
+            solver->clause (clause.data (), clause.size ());
+            clause.clear ();
+            parsed++;
+          }
+        if (chunk.last) restart = chunk.last;
+      }
+    }
+    file->advance (restart);
+    if (done || !more) break;
+    clause.clear ();            // scanned again after 'fill'
+    more = file->fill ();
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
 // Parsing CNF in DIMACS format.
 
 const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
@@ -168,6 +370,34 @@ const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
       if (strict != FORCED)
         solver->reserve (vars);
     }
+  else if (ch == 'b')
+    {
+      const char * err = parse_string ("cnf", 'b');
+      if (err) return err;
+      if (!isspace (ch = parse_char ())) PER ("expected space after 'p bcnf'");
+      do ch = parse_char (); while (ch == ' ' || ch == '\t');
+      if (!isdigit (ch)) PER ("expected digit after 'p bcnf '");
+      err = parse_positive_int (ch, vars, "<max-var>");
+      if (err) return err;
+      if (!isspace (ch)) PER ("expected space after 'p bcnf %d'", vars);
+      do ch = parse_char (); while (ch == ' ' || ch == '\t');
+      if (!isdigit (ch)) PER ("expected digit after 'p bcnf %d '", vars);
+      err = parse_positive_int (ch, clauses, "<num-clauses>");
+      if (err) return err;
+      if (ch == '\r') ch = parse_char ();
+      if (ch != '\n')
+        PER ("expected new-line after 'p bcnf %d %d'", vars, clauses);
+
+      MSG ("found %s'p bcnf %d %d'%s header",
+        tout.green_code (), vars, clauses, tout.normal_code ());
+
+      if (strict != FORCED)
+        solver->reserve (vars);
+      if (parse_inccnf_too)
+        *parse_inccnf_too = false;
+
+      return parse_bcnf (vars, clauses, strict);
+    }
   else if (!parse_inccnf_too)
     PER ("expected 'c' after 'p '");
   else if (ch == 'i')
@@ -202,6 +432,8 @@ const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
   // Now read body of DIMACS part.
   //
   int lit = 0, parsed = 0;
+  if (!found_inccnf_header && file->buffered ())
+    parse_dimacs_buffered (vars, clauses, strict, parsed);
   while ((ch = parse_char ()) != EOF) {
     if (ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r') continue;
     if (ch == 'c') {
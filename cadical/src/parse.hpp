@@ -32,6 +32,9 @@ class Parser {
   const char * parse_string (const char * str, char prev);
   const char * parse_positive_int (int & ch, int & res, const char * name);
   const char * parse_lit (int & ch, int & lit, int & vars, int strict);
+  const char * parse_bcnf (int & vars, int clauses, int strict);
+  void parse_dimacs_buffered (int & vars, int clauses, int strict,
+                              int & parsed);
   const char * parse_dimacs_non_profiled (int & vars, int strict);
   const char * parse_solution_non_profiled ();
 
@@ -59,6 +62,10 @@ public:
   // case the header can not have additional white space, while a value of
   // '1' exactly relaxes this, e.g., 'p cnf \t  1   3  \r\n' becomes legal.
   //
+  // Files with a 'p bcnf <vars> <clauses>' header are also accepted, in
+  // which case the clauses after the header are in binary form (see
+  // 'parse_bcnf' in 'parse.cpp').
+  //
   const char * parse_dimacs (int & vars, int strict);
 
   // Parse a solution file as used in the SAT competition, e.g., with
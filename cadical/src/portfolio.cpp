@@ -0,0 +1,188 @@
+#include "internal.hpp"
+#include "portfolio.hpp"
+
+#include <thread>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Options changed in each worker beyond its seed, cycling through the list
+// for more workers.  The first worker keeps the options of the original.
+
+struct Diversification { const char * name; int val; };
+
+static const Diversification diversifications[][3] = {
+  { { 0, 0 } },
+  { { "phase", 0 } },
+  { { "stabilizeonly", 1 }, { 0, 0 } },
+  { { "stabilize", 0 }, { "walk", 0 }, { 0, 0 } },
+  { { "shuffle", 1 }, { "shufflerandom", 1 }, { 0, 0 } },
+  { { "chrono", 0 }, { "phase", 0 }, { 0, 0 } },
+  { { "elim", 0 }, { 0, 0 } },
+  { { "target", 2 }, { 0, 0 } },
+};
+
+static const int num_diversifications =
+  sizeof diversifications / sizeof *diversifications;
+
+/*------------------------------------------------------------------------*/
+
+// Each worker appends the clauses it exports, each followed by a zero, to
+// its ring.  It first reserves the space of the clause and publishes it
+// only after writing it.  A reader copies a clause from a ring and then
+// checks that the writer did not reserve past the copied part in between,
+// otherwise the copy is discarded.  Readers which fall behind by more than
+// the ring size skip what they missed.
+
+struct Portfolio::Worker : Learner, Importer, Terminator {
+
+  Portfolio * portfolio;
+  Solver * solver;
+  int id, share;
+
+  static const uint64_t capacity = 1u << 20;
+  std::vector<std::atomic<int>> ring;
+  std::atomic<uint64_t> reserved, written;
+  uint64_t position;                    // While exporting a clause.
+
+  std::vector<uint64_t> cursors;        // Read positions in other rings.
+  int64_t exported, imported;
+
+  Worker (Portfolio * p, int i, int s) :
+    portfolio (p), solver (new Solver), id (i), share (s),
+    ring (capacity), reserved (0), written (0), position (0),
+    exported (0), imported (0)
+  { }
+
+  ~Worker () { delete solver; }
+
+  bool learning (int size) {
+    if (size < 1 || size > share) return false;
+    position = written.load (std::memory_order_relaxed);
+    reserved.store (position + size + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    return true;
+  }
+
+  void learn (int lit) {
+    ring[position++ % capacity].store (lit, std::memory_order_relaxed);
+    if (lit) return;
+    written.store (position, std::memory_order_release);
+    exported++;
+  }
+
+  bool import (std::vector<int> & clause) {
+    for (auto other : portfolio->workers) {
+      if (other == this) continue;
+      uint64_t & cursor = cursors[other->id];
+      const uint64_t end = other->written.load (std::memory_order_acquire);
+      if (cursor == end) continue;
+      if (end - cursor > capacity) cursor = end;
+      else {
+        const uint64_t start = cursor;
+        int lit;
+        while ((lit = other->ring[cursor++ % capacity].load (
+                        std::memory_order_relaxed)))
+          clause.push_back (lit);
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (other->reserved.load (std::memory_order_relaxed) - start
+              <= capacity) {
+          imported++;
+          return true;
+        }
+        clause.clear ();
+        cursor = other->written.load (std::memory_order_acquire);
+      }
+    }
+    return false;
+  }
+
+  bool terminate () {
+    if (portfolio->done.load (std::memory_order_relaxed)) return true;
+    return portfolio->terminator && portfolio->terminator->terminate ();
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+Portfolio::Portfolio (Solver & original, int threads, int share) :
+  terminator (0), done (false), winner (-1)
+{
+  assert (threads > 0);
+  const bool sharing = !original.internal->proof && threads > 1;
+  for (int i = 0; i < threads; i++) {
+    Worker * w = new Worker (this, i, share);
+    original.copy (*w->solver);
+    Options & opts = w->solver->internal->opts;
+    if (i) {
+      opts.set ("seed", opts.seed + i);
+      for (const Diversification * d =
+             diversifications[i % num_diversifications]; d->name; d++)
+        opts.set (d->name, d->val);
+      opts.set ("quiet", 1);
+    }
+    w->cursors.resize (threads, 0);
+    w->solver->connect_terminator (w);
+    if (sharing) {
+      w->solver->connect_learner (w);
+      w->solver->connect_importer (w);
+    }
+    workers.push_back (w);
+  }
+}
+
+Portfolio::~Portfolio () {
+  for (auto w : workers)
+    delete w;
+}
+
+void Portfolio::connect_terminator (Terminator * t) { terminator = t; }
+void Portfolio::disconnect_terminator () { terminator = 0; }
+
+void Portfolio::add (int lit) {
+  for (auto w : workers)
+    w->solver->add (lit);
+}
+
+int Portfolio::solve () {
+  done = false;
+  winner = -1;
+  std::atomic<int> result (0);
+  std::vector<std::thread> threads;
+  for (auto w : workers)
+    threads.emplace_back ([this, w, &result] () {
+      const int res = w->solver->solve ();
+      if (res && !done.exchange (true)) winner = w->id, result = res;
+    });
+  for (auto & t : threads)
+    t.join ();
+  return result;
+}
+
+int Portfolio::val (int lit) {
+  assert (winner >= 0);
+  return workers[winner]->solver->val (lit);
+}
+
+Solver & Portfolio::solver (int worker) {
+  assert (0 <= worker), assert (worker < threads ());
+  return *workers[worker]->solver;
+}
+
+void Portfolio::statistics () {
+  Solver & main = *workers[0]->solver;
+  main.section ("portfolio");
+  for (auto w : workers)
+    main.message ("worker %2d: %12" PRId64 " conflicts %10" PRId64
+      " exported %10" PRId64 " imported%s",
+      w->id, w->solver->internal->stats.conflicts,
+      w->exported, w->imported, w->id == winner ? "  (answer)" : "");
+  if (winner >= 0) {
+    Solver & s = *workers[winner]->solver;
+    s.set ("quiet", main.get ("quiet"));
+    s.statistics ();
+  }
+}
+
+}
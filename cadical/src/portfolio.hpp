@@ -0,0 +1,62 @@
+#ifndef _portfolio_hpp_INCLUDED
+#define _portfolio_hpp_INCLUDED
+
+#include "cadical.hpp"
+
+#include <atomic>
+
+namespace CaDiCaL {
+
+// Runs several copies of a solver in parallel, one thread per copy, with
+// different options and seeds.  The copies share their learned units,
+// binary clauses and clauses up to 'share' literals: each worker appends
+// the clauses it learns to its own ring buffer (single writer, no locks)
+// and imports the clauses of the other workers at its restarts (through
+// the 'Learner' and 'Importer' interfaces).  The first worker to answer
+// stops the others.  Sharing is disabled if proofs are traced, since
+// imported clauses could not be justified.
+//
+// The formula, the options and the witness of the given 'original' solver
+// are copied with 'Solver::copy', thus it should not have been solved yet.
+// Further clauses can be added to all workers for incremental use.
+
+class Portfolio {
+
+  struct Worker;
+  std::vector<Worker *> workers;
+  Terminator * terminator;     // External terminator if non-zero.
+  std::atomic<bool> done;      // Set by the first worker with an answer.
+  int winner;
+
+  friend struct Worker;
+
+public:
+
+  Portfolio (Solver & original, int threads, int share = 8);
+  ~Portfolio ();
+
+  int threads () const { return (int) workers.size (); }
+
+  // Checked by all workers, in addition to the first answer.
+  //
+  void connect_terminator (Terminator *);
+  void disconnect_terminator ();
+
+  void add (int lit);           // Added to all workers.
+  int solve ();                 // Same results as 'Solver::solve'.
+  int val (int lit);            // From the worker which found the model.
+
+  // The worker which gave the last answer ('-1' if none).
+  //
+  int solved_by () const { return winner; }
+  Solver & solver (int worker);
+
+  // Conflicts and shared clauses per worker and the statistics of the
+  // worker which gave the last answer.
+  //
+  void statistics ();
+};
+
+}
+
+#endif
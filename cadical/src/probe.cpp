@@ -230,12 +230,10 @@ inline void Internal::probe_propagate2 () {
   while (propagated2 != trail.size ()) {
     const int lit = -trail[propagated2++];
     LOG ("probe propagating %d over binary clauses", -lit);
-    Watches & ws = watches (lit);
-    for (const auto & w : ws) {
-      if (!w.binary ()) continue;
+    for (const auto & w : binaries (lit)) {
       const signed char b = val (w.blit);
       if (b > 0) continue;
-      if (b < 0) conflict = w.clause;                   // but continue
+      if (b < 0) conflict = watched (w);                   // but continue
       else probe_assign (w.blit, -lit);
     }
   }
@@ -255,19 +253,19 @@ bool Internal::probe_propagate () {
       size_t i = 0, j = 0;
       while (i != ws.size ()) {
         const Watch w = ws[j++] = ws[i++];
-        if (w.binary ()) continue;
         const signed char b = val (w.blit);
         if (b > 0) continue;
-        if (w.clause->garbage) continue;
-        const literal_iterator lits = w.clause->begin ();
+        Clause * c = watched (w);
+        if (c->garbage) continue;
+        const literal_iterator lits = c->begin ();
         const int other = lits[0]^lits[1]^lit;
         //lits[0] = other, lits[1] = lit;
         const signed char u = val (other);
         if (u > 0) ws[j-1].blit = other;
         else {
-          const int size = w.clause->size;
+          const int size = c->size;
           const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const literal_iterator middle = lits + c->pos;
           literal_iterator k = middle;
           int r = 0;
           signed char v = -1;
@@ -275,28 +273,28 @@ bool Internal::probe_propagate () {
             k++;
           if (v < 0) {
             k = lits + 2;
-            assert (w.clause->pos <= size);
+            assert (c->pos <= size);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          c->pos = k - lits;
+          assert (lits + 2 <= k), assert (k <= c->end ());
           if (v > 0) ws[j-1].blit = r;
           else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
+            LOG (c, "unwatch %d in", r);
             *k = lit;
             lits[0] = other;
             lits[1] = r;
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
             j--;
           } else if (!u) {
             if (level == 1) {
               lits[0] = other, lits[1] = lit;
-              int dom = hyper_binary_resolve (w.clause);
+              int dom = hyper_binary_resolve (c);
               probe_assign (other, dom);
             } else probe_assign_unit (other);
             probe_propagate2 ();
-          } else conflict = w.clause;
+          } else conflict = c;
         }
       }
       if (j != i) {
@@ -604,7 +602,7 @@ bool Internal::probe_round () {
     if (!propagate ()) {
       LOG ("propagating units after probing results in empty clause");
       learn_empty_clause ();
-    } else sort_watches ();
+    }
   }
 
   int failed = stats.failed - old_failed;
@@ -46,9 +46,17 @@ inline int Internal::assignment_level (int lit, Clause * reason) {
 
 /*------------------------------------------------------------------------*/
 
+// The assignment and propagation functions below are templates with the
+// value of 'opts.chrono' and 'searching_lucky_phases' as parameters, which
+// removes testing them from the hot-spot of the solver.  Both do not change
+// during propagation and the non-template versions dispatch on them.
+
+template<int chrono, bool lucky>
 inline void Internal::search_assign (int lit, Clause * reason) {
 
   if (level) require_mode (SEARCH);
+  assert (chrono == opts.chrono);
+  assert (lucky == searching_lucky_phases);
 
   const int idx = vidx (lit);
   assert (!vals[idx]);
@@ -61,7 +69,7 @@ inline void Internal::search_assign (int lit, Clause * reason) {
   //
   if (!reason) lit_level = 0;   // unit
   else if (reason == decision_reason) lit_level = level, reason = 0;
-  else if (opts.chrono) lit_level = assignment_level (lit, reason);
+  else if (chrono) lit_level = assignment_level (lit, reason);
   else lit_level = level;
   if (!lit_level) reason = 0;
 
@@ -74,7 +82,7 @@ inline void Internal::search_assign (int lit, Clause * reason) {
   vals[-idx] = -tmp;
   assert (val (lit) > 0);
   assert (val (-lit) < 0);
-  if (!searching_lucky_phases)
+  if (!lucky)
     phases.saved[idx] = tmp;                // phase saving during search
   trail.push_back (lit);
 #ifdef LOGGING
@@ -83,11 +91,10 @@ inline void Internal::search_assign (int lit, Clause * reason) {
 #endif
 
   if (watching ()) {
+    const Watches & bs = binaries (-lit);
+    if (!bs.empty ()) __builtin_prefetch (&bs[0], 0, 1);
     const Watches & ws = watches (-lit);
-    if (!ws.empty ()) {
-      const Watch & w = ws[0];
-      __builtin_prefetch (&w, 0, 1);
-    }
+    if (!ws.empty ()) __builtin_prefetch (&ws[0], 0, 1);
   }
 }
 
@@ -99,6 +106,25 @@ inline void Internal::search_assign (int lit, Clause * reason) {
 // clause.  This happens far less frequently than the 'search_assign' above,
 // which is called directly in 'propagate' below and thus is inlined.
 
+void Internal::search_assign (int lit, Clause * reason) {
+  const bool lucky = searching_lucky_phases;
+  switch (opts.chrono) {
+    case 0:
+      if (lucky) search_assign<0, true> (lit, reason);
+      else search_assign<0, false> (lit, reason);
+      break;
+    case 1:
+      if (lucky) search_assign<1, true> (lit, reason);
+      else search_assign<1, false> (lit, reason);
+      break;
+    default:
+      assert (opts.chrono == 2);
+      if (lucky) search_assign<2, true> (lit, reason);
+      else search_assign<2, false> (lit, reason);
+      break;
+  }
+}
+
 void Internal::assign_unit (int lit) {
   assert (!level);
   search_assign (lit, 0);
@@ -131,50 +157,52 @@ void Internal::search_assign_driving (int lit, Clause * c) {
 // This version of 'propagate' uses lazy watches and keeps two watched
 // literals at the beginning of the clause.  We also use 'blocking literals'
 // to reduce the number of times clauses have to be visited (2008 JSAT paper
-// by Chu, Harwood and Stuckey).  The watches know if a watched clause is
-// binary, in which case it never has to be visited.  If a binary clause is
-// falsified we continue propagating.
+// by Chu, Harwood and Stuckey).  Binary clauses are watched in separate
+// lists of 'binaries', never have to be visited and are propagated before
+// long clauses.  If a binary clause is falsified we continue propagating
+// binary clauses but stop before visiting long clauses.
 
 // Finally, for long clauses we save the position of the last watch
 // replacement in 'pos', which in turn reduces certain quadratic accumulated
 // propagation costs (2013 JAIR article by Ian Gent) at the expense of four
 // more bytes for each clause.
 
+template<int chrono, bool lucky>
 bool Internal::propagate () {
 
   if (level) require_mode (SEARCH);
   assert (!unsat);
+  assert (chrono == opts.chrono);
+  assert (lucky == searching_lucky_phases);
 
   START (propagate);
 
   // Updating statistics counter in the propagation loops is costly so we
   // delay until propagation ran to completion.
   //
-  int64_t before = propagated;
-
-  while (!conflict && propagated != trail.size ()) {
+  int64_t before = propagated2 = propagated;
 
-    const int lit = -trail[propagated++];
-    LOG ("propagating %d", -lit);
-    Watches & ws = watches (lit);
+  while (!conflict) {
 
-    const const_watch_iterator eow = ws.end ();
-    watch_iterator j = ws.begin ();
-    const_watch_iterator i = j;
+    // Binary clauses are propagated for all literals on the trail first,
+    // before any long clause is visited, similar to 'probe_propagate2'.
+    // Since binary implications are cheap to propagate and come in large
+    // numbers this finds conflicts earlier and with shorter reasons.
 
-    while (i != eow) {
+    if (propagated2 != trail.size ()) {
 
-      const Watch w = *j++ = *i++;
-      const signed char b = val (w.blit);
+      const int lit = -trail[propagated2++];
+      LOG ("propagating %d over binary clauses", -lit);
 
-      if (b > 0) continue;                // blocking literal satisfied
+      for (const auto & w : binaries (lit)) {
 
-      if (w.binary ()) {
+        const signed char b = val (w.blit);
+        if (b > 0) continue;              // other literal satisfied
 
         // In principle we can ignore garbage binary clauses too, but that
         // would require to dereference the clause pointer all the time with
         //
-        // if (w.clause->garbage) { j--; continue; } // (*)
+        // if (watched (w)->garbage) continue; // (*)
         //
         // This is too costly.  It is however necessary to produce correct
         // proof traces if binary clauses are traced to be deleted ('d ...'
@@ -192,150 +220,168 @@ bool Internal::propagate () {
         // instances where this happens (which I found), and then
         // implemented the described fix.
 
-        // Binary clauses are treated separately since they do not require
-        // to access the clause at all (only during conflict analysis, and
-        // there also only to simplify the code).
+        // Binary clauses do not require to access the clause at all (only
+        // during conflict analysis, and there also only to simplify the
+        // code).
 
-        if (b < 0) conflict = w.clause;          // but continue ...
-        else search_assign (w.blit, w.clause);
+        if (b < 0) conflict = watched (w);          // but continue ...
+        else search_assign<chrono, lucky> (w.blit, watched (w));
+      }
 
-      } else {
+      continue;
+    }
 
-        if (conflict) break; // Stop if there was a binary conflict already.
+    if (propagated == trail.size ()) break;
 
-        // The cache line with the clause data is forced to be loaded here
-        // and thus this first memory access below is the real hot-spot of
-        // the solver.  Note, that this check is positive very rarely and
-        // thus branch prediction should be almost perfect here.
+    const int lit = -trail[propagated++];
+    LOG ("propagating %d over large clauses", -lit);
+    Watches & ws = watches (lit);
 
-        if (w.clause->garbage) { j--; continue; }
+    const const_watch_iterator eow = ws.end ();
+    watch_iterator j = ws.begin ();
+    const_watch_iterator i = j;
 
-        literal_iterator lits = w.clause->begin ();
+    while (i != eow) {
 
-        // Simplify code by forcing 'lit' to be the second literal in the
-        // clause.  This goes back to MiniSAT.  We use a branch-less version
-        // for conditionally swapping the first two literals, since it
-        // turned out to be substantially faster than this one
-        //
-        //  if (lits[0] == lit) swap (lits[0], lits[1]);
-        //
-        // which achieves the same effect, but needs a branch.
-        //
-        const int other = lits[0] ^ lits[1] ^ lit;
-        const signed char u = val (other); // value of the other watch
+      const Watch w = *j++ = *i++;
+      assert (!w.binary ());
+      const signed char b = val (w.blit);
 
-        if (u > 0) j[-1].blit = other; // satisfied, just replace blit
-        else {
+      if (b > 0) continue;                // blocking literal satisfied
 
-          // This follows Ian Gent's (JAIR'13) idea of saving the position
-          // of the last watch replacement.  In essence it needs two copies
-          // of the default search for a watch replacement (in essence the
-          // code in the 'if (v < 0) { ... }' block below), one starting at
-          // the saved position until the end of the clause and then if that
-          // one failed to find a replacement another one starting at the
-          // first non-watched literal until the saved position.
+      // The cache line with the clause data is forced to be loaded here
+      // and thus this first memory access below is the real hot-spot of
+      // the solver.  Note, that this check is positive very rarely and
+      // thus branch prediction should be almost perfect here.
 
-          const int size = w.clause->size;
-          const literal_iterator middle = lits + w.clause->pos;
-          const const_literal_iterator end = lits + size;
-          literal_iterator k = middle;
+      Clause * c = watched (w);
+      if (c->garbage) { j--; continue; }
 
-          // Find replacement watch 'r' at position 'k' with value 'v'.
+      literal_iterator lits = c->begin ();
 
-          int r = 0;
-          signed char v = -1;
+      // Simplify code by forcing 'lit' to be the second literal in the
+      // clause.  This goes back to MiniSAT.  We use a branch-less version
+      // for conditionally swapping the first two literals, since it
+      // turned out to be substantially faster than this one
+      //
+      //  if (lits[0] == lit) swap (lits[0], lits[1]);
+      //
+      // which achieves the same effect, but needs a branch.
+      //
+      const int other = lits[0] ^ lits[1] ^ lit;
+      const signed char u = val (other); // value of the other watch
 
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
+      if (u > 0) j[-1].blit = other; // satisfied, just replace blit
+      else {
 
-          if (v < 0) {  // need second search starting at the head?
+        // This follows Ian Gent's (JAIR'13) idea of saving the position
+        // of the last watch replacement.  In essence it needs two copies
+        // of the default search for a watch replacement (in essence the
+        // code in the 'if (v < 0) { ... }' block below), one starting at
+        // the saved position until the end of the clause and then if that
+        // one failed to find a replacement another one starting at the
+        // first non-watched literal until the saved position.
 
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
-          }
+        const int size = c->size;
+        const literal_iterator middle = lits + c->pos;
+        const const_literal_iterator end = lits + size;
+        literal_iterator k = middle;
 
-          w.clause->pos = k - lits;  // always save position
+        // Find replacement watch 'r' at position 'k' with value 'v'.
 
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+        int r = 0;
+        signed char v = -1;
 
-          if (v > 0) {
+        while (k != end && (v = val (r = *k)) < 0)
+          k++;
 
-            // Replacement satisfied, so just replace 'blit'.
+        if (v < 0) {  // need second search starting at the head?
 
-            j[-1].blit = r;
+          k = lits + 2;
+          assert (c->pos <= size);
+          while (k != middle && (v = val (r = *k)) < 0)
+            k++;
+        }
 
-          } else if (!v) {
+        c->pos = k - lits;  // always save position
 
-            // Found new unassigned replacement literal to be watched.
+        assert (lits + 2 <= k), assert (k <= c->end ());
 
-            LOG (w.clause, "unwatch %d in", lit);
+        if (v > 0) {
 
-            lits[0] = other;
-            lits[1] = r;
-            *k = lit;
+          // Replacement satisfied, so just replace 'blit'.
 
-            watch_literal (r, lit, w.clause);
+          j[-1].blit = r;
 
-            j--;  // Drop this watch from the watch list of 'lit'.
+        } else if (!v) {
 
-          } else if (!u) {
+          // Found new unassigned replacement literal to be watched.
 
-            assert (v < 0);
+          LOG (c, "unwatch %d in", lit);
 
-            // The other watch is unassigned ('!u') and all other literals
-            // assigned to false (still 'v < 0'), thus we found a unit.
-            //
-            search_assign (other, w.clause);
+          lits[0] = other;
+          lits[1] = r;
+          *k = lit;
 
-            // Similar code is in the implementation of the SAT'18 paper on
-            // chronological backtracking but in our experience, this code
-            // first does not really seem to be necessary for correctness,
-            // and further does not improve running time either.
-            //
-            if (opts.chrono > 1) {
+          watch_literal (r, lit, c);
 
-              const int other_level = var (other).level;
+          j--;  // Drop this watch from the watch list of 'lit'.
 
-              if (other_level > var (lit).level) {
+        } else if (!u) {
 
-                // The assignment level of the new unit 'other' is larger
-                // than the assignment level of 'lit'.  Thus we should find
-                // another literal in the clause at that higher assignment
-                // level and watch that instead of 'lit'.
+          assert (v < 0);
 
-                assert (size > 2);
+          // The other watch is unassigned ('!u') and all other literals
+          // assigned to false (still 'v < 0'), thus we found a unit.
+          //
+          search_assign<chrono, lucky> (other, c);
 
-                int pos, s = 0;
+          // Similar code is in the implementation of the SAT'18 paper on
+          // chronological backtracking but in our experience, this code
+          // first does not really seem to be necessary for correctness,
+          // and further does not improve running time either.
+          //
+          if (chrono > 1) {
 
-                for (pos = 2; pos < size; pos++)
-                  if (var (s = lits[pos]).level == other_level)
-                    break;
+            const int other_level = var (other).level;
 
-                assert (s);
-                assert (pos < size);
+            if (other_level > var (lit).level) {
 
-                LOG (w.clause, "unwatch %d in", lit);
-                lits[pos] = lit;
-                lits[0] = other;
-                lits[1] = s;
-                watch_literal (s, other, w.clause);
+              // The assignment level of the new unit 'other' is larger
+              // than the assignment level of 'lit'.  Thus we should find
+              // another literal in the clause at that higher assignment
+              // level and watch that instead of 'lit'.
 
-                j--;  // Drop this watch from the watch list of 'lit'.
-              }
-            }
-          } else {
+              assert (size > 2);
+
+              int pos, s = 0;
+
+              for (pos = 2; pos < size; pos++)
+                if (var (s = lits[pos]).level == other_level)
+                  break;
 
-            assert (u < 0);
-            assert (v < 0);
+              assert (s);
+              assert (pos < size);
 
-            // The other watch is assigned false ('u < 0') and all other
-            // literals as well (still 'v < 0'), thus we found a conflict.
+              LOG (c, "unwatch %d in", lit);
+              lits[pos] = lit;
+              lits[0] = other;
+              lits[1] = s;
+              watch_literal (s, other, c);
 
-            conflict = w.clause;
-            break;
+              j--;  // Drop this watch from the watch list of 'lit'.
+            }
           }
+        } else {
+
+          assert (u < 0);
+          assert (v < 0);
+
+          // The other watch is assigned false ('u < 0') and all other
+          // literals as well (still 'v < 0'), thus we found a conflict.
+
+          conflict = c;
+          break;
         }
       }
     }
@@ -349,7 +395,7 @@ bool Internal::propagate () {
     }
   }
 
-  if (searching_lucky_phases) {
+  if (lucky) {
 
     if (conflict)
       LOG (conflict, "ignoring lucky conflict");
@@ -379,4 +425,15 @@ bool Internal::propagate () {
   return !conflict;
 }
 
+bool Internal::propagate () {
+  const bool lucky = searching_lucky_phases;
+  switch (opts.chrono) {
+    case 0: return lucky ? propagate<0, true> () : propagate<0, false> ();
+    case 1: return lucky ? propagate<1, true> () : propagate<1, false> ();
+    default:
+      assert (opts.chrono == 2);
+      return lucky ? propagate<2, true> () : propagate<2, false> ();
+  }
+}
+
 }
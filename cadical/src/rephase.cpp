@@ -92,9 +92,15 @@ char Internal::rephase_best () {
 
 char Internal::rephase_walk () {
   stats.rephased.walk++;
-  PHASE ("rephase", stats.rephased.total,
-    "starting local search to improve current phase");
-  walk ();
+  if (walkthread) {
+    PHASE ("rephase", stats.rephased.total,
+      "importing phases of concurrent local search");
+    import_walk_phases ();
+  } else {
+    PHASE ("rephase", stats.rephased.total,
+      "starting local search to improve current phase");
+    walk ();
+  }
   return 'W';
 }
 
@@ -102,6 +102,7 @@ void Internal::restart () {
   if (stable) stats.restartstable++;
   LOG ("restart %" PRId64 "", stats.restarts);
   backtrack (reuse_trail ());
+  if (external->importer) import_clauses ();
 
   lim.restart = stats.conflicts + opts.restartint;
   LOG ("new restart limit at %" PRId64 " conflicts", lim.restart);
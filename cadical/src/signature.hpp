@@ -0,0 +1,83 @@
+#ifndef _signature_hpp_INCLUDED
+#define _signature_hpp_INCLUDED
+
+#include "util.hpp"     // Alphabetically after 'signature'.
+
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace CaDiCaL {
+
+using namespace std;
+
+// Clause signatures are 64-bit Bloom filters over the variables of a clause
+// as in the original SATeLite implementation.  A clause 'd' can only
+// subsume or strengthen a clause 'c' if all variables of 'd' occur in 'c'
+// and thus if the signature of 'd' is a subset of the signature of 'c'.
+// We hash variables instead of literals, since otherwise strengthening
+// (where one literal occurs negated) would be filtered out too.
+
+typedef vector<uint64_t> Sigs;
+
+inline void erase_sigs (Sigs & ss) { erase_vector (ss); }
+
+inline uint64_t signature_bit (int lit) {
+  const unsigned hash = (unsigned) abs (lit) * 0x9e3779b1u;
+  return (uint64_t) 1 << (hash >> 26);
+}
+
+template<class I> inline uint64_t signature (I begin, I end) {
+  uint64_t res = 0;
+  for (I i = begin; i != end; i++)
+    res |= signature_bit (*i);
+  return res;
+}
+
+// Check up to 64 signatures at once and return a bit-mask in which bit 'i'
+// is set iff 'sigs[i]' is a subset of 'sig', i.e., the corresponding clause
+// survives the filter and needs a real subsumption check.  This is the
+// inner loop of forward subsumption and thus vectorized if possible.
+
+inline uint64_t signature_mask (const uint64_t * sigs, size_t n,
+                                uint64_t sig) {
+  assert (n <= 64);
+  uint64_t res = 0;
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i s = _mm256_set1_epi64x ((long long) sig);
+  const __m256i z = _mm256_setzero_si256 ();
+  for (; i + 4 <= n; i += 4) {
+    const __m256i v = _mm256_loadu_si256 ((const __m256i*) (sigs + i));
+    const __m256i e = _mm256_cmpeq_epi64 (_mm256_andnot_si256 (s, v), z);
+    const unsigned m = _mm256_movemask_pd (_mm256_castsi256_pd (e));
+    res |= (uint64_t) m << i;
+  }
+#elif defined(__SSE2__)
+  // There is no 64-bit comparison before SSE4.1, thus compare the 32-bit
+  // halves and require both to be zero.
+  //
+  const __m128i s = _mm_set1_epi64x ((long long) sig);
+  const __m128i z = _mm_setzero_si128 ();
+  for (; i + 2 <= n; i += 2) {
+    const __m128i v = _mm_loadu_si128 ((const __m128i*) (sigs + i));
+    const __m128i e = _mm_cmpeq_epi32 (_mm_andnot_si128 (s, v), z);
+    const unsigned m = _mm_movemask_epi8 (e);
+    const uint64_t lo = ((m & 0xff) == 0xff), hi = ((m >> 8) == 0xff);
+    res |= (lo | (hi << 1)) << i;
+  }
+#endif
+  for (; i < n; i++)
+    if (!(sigs[i] & ~sig))
+      res |= (uint64_t) 1 << i;
+  return res;
+}
+
+}
+
+#endif
@@ -449,6 +449,28 @@ int Solver::get (const char * arg) {
   return internal->opts.get (arg);
 }
 
+int64_t Solver::get_statistic_value (const char * name) const {
+  REQUIRE_VALID_OR_SOLVING_STATE ();
+  const Stats & stats = internal->stats;
+  if (!strcmp (name, "conflicts")) return stats.conflicts;
+  if (!strcmp (name, "decisions")) return stats.decisions;
+  if (!strcmp (name, "propagations"))
+    return stats.propagations.cover + stats.propagations.instantiate +
+           stats.propagations.probe + stats.propagations.search +
+           stats.propagations.transred + stats.propagations.vivify +
+           stats.propagations.walk;
+  if (!strcmp (name, "restarts")) return stats.restarts;
+  if (!strcmp (name, "learned")) return stats.learned.clauses;
+  if (!strcmp (name, "units")) return stats.units;
+  if (!strcmp (name, "binaries")) return stats.binaries;
+  if (!strcmp (name, "imported")) return stats.imported.clauses;
+  if (!strcmp (name, "fixed")) return stats.all.fixed;
+  if (!strcmp (name, "eliminated")) return stats.all.eliminated;
+  if (!strcmp (name, "memory")) return current_resident_set_size ();
+  if (!strcmp (name, "maxmemory")) return maximum_resident_set_size ();
+  return -1;
+}
+
 bool Solver::set (const char * arg, int val) {
   TRACE ("set", arg, val);
   REQUIRE_VALID_STATE ();
@@ -536,6 +558,28 @@ void Solver::add (int lit) {
   LOG_API_CALL_END ("add", lit);
 }
 
+void Solver::clause (const int * lits, size_t size) {
+  REQUIRE_VALID_STATE ();
+  REQUIRE (!adding_clause, "clause not terminated");
+  REQUIRE (!size || lits, "zero literals pointer");
+#ifndef NTRACING
+  if (trace_api_file) {
+    for (size_t i = 0; i < size; i++)
+      add (lits[i]);
+    add (0);
+    return;
+  }
+#endif
+  transition_to_unknown_state ();
+  const int * const end = lits + size;
+  for (const int * p = lits; p != end; p++) {
+    REQUIRE_VALID_LIT (*p);
+    external->add (*p);
+  }
+  external->add (0);
+  if (!adding_constraint) STATE (UNKNOWN);
+}
+
 void Solver::constrain (int lit) {
   TRACE ("constrain", lit);
   REQUIRE_VALID_STATE ();
@@ -770,6 +814,33 @@ void Solver::disconnect_learner () {
   LOG_API_CALL_END ("disconnect_learner");
 }
 
+void Solver::connect_importer (Importer * importer) {
+  LOG_API_CALL_BEGIN ("connect_importer");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (importer, "can not connect zero importer");
+#ifdef LOGGING
+  if (external->importer)
+    LOG ("connecting new importer (disconnecting previous one)");
+  else
+    LOG ("connecting new importer (no previous one)");
+#endif
+  external->importer = importer;
+  LOG_API_CALL_END ("connect_importer");
+}
+
+void Solver::disconnect_importer () {
+  LOG_API_CALL_BEGIN ("disconnect_importer");
+  REQUIRE_VALID_STATE ();
+#ifdef LOGGING
+    if (external->importer)
+      LOG ("disconnecting previous importer");
+    else
+      LOG ("ignoring to disconnect importer (no previous one)");
+#endif
+  external->importer = 0;
+  LOG_API_CALL_END ("disconnect_importer");
+}
+
 /*===== IPASIR END =======================================================*/
 
 int Solver::active () const {
@@ -128,6 +128,11 @@ void Stats::print (Internal * internal) {
   PRT ("  hyper:         %15" PRId64 "   %10.2f %%  per conflict", stats.flush.hyper, relative (stats.flush.hyper, stats.conflicts));
   PRT ("  flushings:     %15" PRId64 "   %10.2f    interval", stats.flush.count, relative (stats.conflicts, stats.flush.count));
   }
+  if (all || stats.imported.clauses || stats.imported.dropped) {
+  PRT ("imported:        %15" PRId64 "   %10.2f %%  per conflict", stats.imported.clauses, percent (stats.imported.clauses, stats.conflicts));
+  PRT ("  units:         %15" PRId64 "   %10.2f %%  of imported", stats.imported.units, percent (stats.imported.units, stats.imported.clauses));
+  PRT ("  dropped:       %15" PRId64 "   %10.2f %%  of tried", stats.imported.dropped, percent (stats.imported.dropped, stats.imported.clauses + stats.imported.dropped));
+  }
   if (all || stats.instantiated) {
   PRT ("instantiated:    %15" PRId64 "   %10.2f %%  of tried", stats.instantiated, percent (stats.instantiated, stats.instried));
   PRT ("  instrounds:    %15" PRId64 "   %10.2f %%  of elimrounds", stats.instrounds, percent (stats.instrounds, stats.elimrounds));
@@ -215,6 +220,7 @@ void Stats::print (Internal * internal) {
   PRT ("  subtried:      %15" PRId64 "   %10.2f    tried per subsumed", stats.subtried, relative (stats.subtried, stats.subsumed));
   PRT ("  subchecks:     %15" PRId64 "   %10.2f    per tried", stats.subchecks, relative (stats.subchecks, stats.subtried));
   PRT ("  subchecks2:    %15" PRId64 "   %10.2f %%  per subcheck", stats.subchecks2, percent (stats.subchecks2, stats.subchecks));
+  PRT ("  subfiltered:   %15" PRId64 "   %10.2f %%  per candidate", stats.subfiltered, percent (stats.subfiltered, stats.subchecks + stats.subfiltered));
   PRT ("  elimotfsub:    %15" PRId64 "   %10.2f %%  of subsumed", stats.elimotfsub, percent (stats.elimotfsub, stats.subsumed));
   PRT ("  elimbwsub:     %15" PRId64 "   %10.2f %%  of subsumed", stats.elimbwsub, percent (stats.elimbwsub, stats.subsumed));
   PRT ("  eagersub:      %15" PRId64 "   %10.2f %%  of subsumed", stats.eagersub, percent (stats.eagersub, stats.subsumed));
@@ -257,6 +263,8 @@ void Stats::print (Internal * internal) {
   if (stats.walk.minimum < LONG_MAX)
   PRT ("  minimum:       %15" PRId64 "   %10.2f %%  clauses", stats.walk.minimum, percent (stats.walk.minimum, stats.added.irredundant));
   PRT ("  broken:        %15" PRId64 "   %10.2f    per flip", stats.walk.broken, relative (stats.walk.broken, stats.walk.flips));
+  if (stats.walk.concurrent)
+  PRT ("  concurrent:    %15" PRId64 "   %10.2f    per walk", stats.walk.concurrent, relative (stats.walk.concurrent, stats.walk.count));
   }
   if (all || stats.weakened) {
   PRT ("weakened:        %15" PRId64 "   %10.2f    average size", stats.weakened, relative (stats.weakenedlen, stats.weakened));
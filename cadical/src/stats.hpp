@@ -83,6 +83,7 @@ struct Stats {
     int64_t broken;
     int64_t flips;
     int64_t minimum;
+    int64_t concurrent; // flips on concurrent walker thread
   } walk;
 
   struct {
@@ -132,6 +133,7 @@ struct Stats {
   int64_t subtried;     // number of tried subsumptions
   int64_t subchecks;    // number of pair-wise subsumption checks
   int64_t subchecks2;   // same but restricted to binary clauses
+  int64_t subfiltered;  // candidates filtered by clause signatures
   int64_t elimotfsub;   // number of on-the-fly subsumed during elimination
   int64_t subsumerounds;// number of subsumption rounds
   int64_t subsumephases;// number of scheduled subsumption phases
@@ -183,6 +185,12 @@ struct Stats {
   int64_t garbage;      // bytes current irredundant garbage clauses
   int64_t units;        // learned unit clauses
   int64_t binaries;     // learned binary clauses
+
+  struct {
+    int64_t clauses;    // imported clauses (including units)
+    int64_t units;      // imported unit clauses
+    int64_t dropped;    // dropped since not all variables active
+  } imported;
   int64_t probingphases;// number of scheduled probing phases
   int64_t probingrounds;// number of probing rounds
   int64_t probesuccess; // number successful probing phases
@@ -189,6 +189,9 @@ Internal::try_to_subsume_clause (Clause * c, vector<Clause *> & shrunken) {
 
   Clause dummy; // Communicate binary subsuming clause.
 
+  const uint64_t sig = signature (c->begin (), c->end ());
+  const bool filter = opts.subsumesigs;
+
   Clause * d = 0;
   int flipped = 0;
 
@@ -245,14 +248,31 @@ Internal::try_to_subsume_clause (Clause * c, vector<Clause *> & shrunken) {
       // as above for communicating 'subsumption' or 'strengthening' to the
       // code after the loop is used.
       //
+      // Before calling 'subsume_check' the signatures of up to 64 watched
+      // clauses are compared against the signature of the candidate at
+      // once, which avoids accessing most of the watched clauses at all.
+      //
       const Occs & os = occs (sign * lit);
-      for (const auto & e : os) {
-        assert (!e->garbage);                   // sanity check
-        if (e->garbage) continue;               // defensive: not needed
-        flipped = subsume_check (e, c);
-        if (!flipped) continue;
-        d = e;                                  // leave also outer loop
-        break;
+      const Sigs & ss = sigs (sign * lit);
+      assert (os.size () == ss.size ());
+      const size_t size = os.size ();
+      for (size_t i = 0; !d && i < size; i += 64) {
+        const size_t n = min (size - i, (size_t) 64);
+        uint64_t mask;
+        if (filter) mask = signature_mask (&ss[i], n, sig);
+        else if (n < 64) mask = ((uint64_t) 1 << n) - 1;
+        else mask = ~(uint64_t) 0;
+        stats.subfiltered += n - __builtin_popcountll (mask);
+        while (mask) {
+          Clause * e = os[i + __builtin_ctzll (mask)];
+          mask &= mask - 1;
+          assert (!e->garbage);                 // sanity check
+          if (e->garbage) continue;             // defensive: not needed
+          flipped = subsume_check (e, c);
+          if (!flipped) continue;
+          d = e;                                // leave also outer loop
+          break;
+        }
       }
     }
 
@@ -429,6 +449,7 @@ bool Internal::subsume_round () {
   vector<Clause *> shrunken;
   init_occs ();
   init_bins ();
+  init_sigs ();
 
   for (const auto & s : schedule) {
 
@@ -495,6 +516,7 @@ bool Internal::subsume_round () {
         minlit, minsize, minoccs);
 
       occs (minlit).push_back (c);
+      sigs (minlit).push_back (signature (c->begin (), c->end ()));
 
       // This sorting should give faster failures for assumption checks
       // since the less occurring variables are put first in a clause and
@@ -546,6 +568,7 @@ bool Internal::subsume_round () {
   reset_noccs ();
   reset_occs ();
   reset_bins ();
+  reset_sigs ();
 
   // Reset all old 'added' flags and mark variables in shrunken
   // clauses as 'added' for the next subsumption round.
@@ -58,11 +58,6 @@ void Internal::transred () {
     i = clauses.begin ();
   }
 
-  // Move watches of binary clauses to the front. Thus we can stop iterating
-  // watches as soon a long clause is found during watch traversal.
-  //
-  sort_watches ();
-
   // This working stack plays the same role as the 'trail' during standard
   // propagation.
   //
@@ -94,13 +89,13 @@ void Internal::transred () {
 
     // Find a different path from 'src' to 'dst' in the binary implication
     // graph, not using 'c'.  Since this is the same as checking whether
-    // there is a path from '-dst' to '-src', we can do the reverse search
-    // if the number of watches of '-dst' is larger than those of 'src'.
+    // there is a path from '-dst' to '-src', we can do the reverse search if
+    // the number of binary watches of '-dst' is larger than those of 'src'.
     //
     int src = -c->literals[0];
     int dst = c->literals[1];
     if (val (src) || val (dst)) continue;
-    if (watches (-src).size () < watches (dst).size ()) {
+    if (binaries (-src).size () < binaries (dst).size ()) {
       int tmp = dst;
       dst = -src; src = -tmp;
     }
@@ -128,13 +123,12 @@ void Internal::transred () {
       assert (marked (lit) > 0);
       LOG ("transred propagating %d", lit);
       propagations++;
-      const Watches & ws = watches (-lit);
+      const Watches & ws = binaries (-lit);
       const const_watch_iterator eow = ws.end ();
       const_watch_iterator k;
       for (k = ws.begin (); !transitive && !failed && k != eow; k++) {
         const Watch & w = *k;
-        if (!w.binary ()) break;        // since we sorted watches above
-        Clause * d = w.clause;
+        Clause * d = watched (w);
         if (d == c) continue;
         if (irredundant && d->redundant) continue;
         if (d->garbage) continue;
@@ -90,13 +90,11 @@ bool Internal::vivify_propagate () {
     if (propagated2 != trail.size ()) {
       const int lit = -trail[propagated2++];
       LOG ("vivify propagating %d over binary clauses", -lit);
-      Watches & ws = watches (lit);
-      for (const auto & w : ws) {
-        if (!w.binary ()) continue;
+      for (const auto & w : binaries (lit)) {
         const signed char b = val (w.blit);
         if (b > 0) continue;
-        if (b < 0) conflict = w.clause;                 // but continue
-        else vivify_assign (w.blit, w.clause);
+        if (b < 0) conflict = watched (w);                 // but continue
+        else vivify_assign (w.blit, watched (w));
       }
     } else if (!conflict && propagated != trail.size ()) {
       const int lit = -trail[propagated++];
@@ -107,18 +105,18 @@ bool Internal::vivify_propagate () {
       watch_iterator j = ws.begin ();
       while (i != eow) {
         const Watch w = *j++ = *i++;
-        if (w.binary ()) continue;
         if (val (w.blit) > 0) continue;
-        if (w.clause->garbage) { j--; continue; }
-        if (w.clause == ignore) continue;
-        literal_iterator lits = w.clause->begin ();
+        Clause * c = watched (w);
+        if (c->garbage) { j--; continue; }
+        if (c == ignore) continue;
+        literal_iterator lits = c->begin ();
         const int other = lits[0]^lits[1]^lit;
         const signed char u = val (other);
         if (u > 0) j[-1].blit = other;
         else {
-          const int size = w.clause->size;
+          const int size = c->size;
           const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const literal_iterator middle = lits + c->pos;
           literal_iterator k = middle;
           signed char v = -1;
           int r = 0;
@@ -126,27 +124,27 @@ bool Internal::vivify_propagate () {
             k++;
           if (v < 0) {
             k = lits + 2;
-            assert (w.clause->pos <= size);
+            assert (c->pos <= size);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          c->pos = k - lits;
+          assert (lits + 2 <= k), assert (k <= c->end ());
           if (v > 0) j[-1].blit = r;
           else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
+            LOG (c, "unwatch %d in", r);
             lits[0] = other;
             lits[1] = r;
             *k = lit;
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
             j--;
           } else if (!u) {
             assert (v < 0);
-            vivify_assign (other, w.clause);
+            vivify_assign (other, c);
           } else {
             assert (u < 0);
             assert (v < 0);
-            conflict = w.clause;
+            conflict = c;
             break;
           }
         }
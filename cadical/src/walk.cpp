@@ -1,5 +1,9 @@
 #include "internal.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
@@ -99,6 +103,18 @@ inline double Walker::score (unsigned i) {
 
 /*------------------------------------------------------------------------*/
 
+// Local search uses a one-watch scheme in which binary clauses are watched
+// together with long clauses in 'watches' and not in 'binaries'.
+
+inline void
+Internal::walk_watch_literal (int lit, int blit, Clause * c) {
+  assert (lit != blit);
+  watches (lit).push_back (Watch (blit, arena.reference (c), c->size == 2));
+  LOG (c, "watch %d blit %d in", lit, blit);
+}
+
+/*------------------------------------------------------------------------*/
+
 Clause * Internal::walk_pick_clause (Walker & walker) {
   require_mode (WALK);
   assert (!walker.broken.empty ());
@@ -127,7 +143,7 @@ unsigned Internal::walk_break_value (int lit) {
     if (val (w.blit) > 0) continue;
     if (w.binary ()) { res++; continue; }
 
-    Clause * c = w.clause;
+    Clause * c = watched (w);
     assert (lit == c->literals[0]);
 
     // Now try to find a second satisfied literal starting at 'literals[1]'
@@ -296,7 +312,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
       if (prev == lit) {
         literals[0] = lit;
         LOG (d, "made");
-        watch_literal (literals[0], literals[1], d);
+        walk_watch_literal (literals[0], literals[1], d);
         made++;
         j--;
 
@@ -335,7 +351,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
     LOG ("trying to brake %zd watched clauses", ws.size ());
 
     for (const auto & w : ws) {
-      Clause * d = w.clause;
+      Clause * d = watched (w);
       LOG (d, "unwatch %d in", -lit);
       int * literals = d->literals, replacement = 0, prev = -lit;
       assert (literals[0] == -lit);
@@ -354,7 +370,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
         literals[1] = -lit;
         literals[0] = replacement;
         assert (-lit != replacement);
-        watch_literal (replacement, -lit, d);
+        walk_watch_literal (replacement, -lit, d);
       } else {
         for (int i = size-1; i > 0; i--) {      // undo shift
           const int other = literals[i];
@@ -538,7 +554,7 @@ int Internal::walk_round (int64_t limit, bool prev) {
       }
 
       if (satisfied) {
-        watch_literal (lits[0], lits[1], c);
+        walk_watch_literal (lits[0], lits[1], c);
 #ifdef LOGGING
         watched++;
 #endif
@@ -664,4 +680,212 @@ void Internal::walk () {
   STOP_INNER_WALK ();
 }
 
+/*------------------------------------------------------------------------*/
+
+// With 'walkthread' local search runs concurrently to CDCL on its own
+// thread instead of interrupting the search during 'rephase'.  It works on
+// a snapshot of the irredundant clauses taken at the start of 'solve',
+// after preprocessing, with root level assigned literals removed.  The
+// snapshot uses external literals since variables might be compacted by
+// the CDCL thread in the mean time.  Local search keeps flipping with the
+// 'ProbSAT' scheme above, but on its own occurrence lists, and publishes
+// every new minimum of falsified clauses, which is then imported as saved
+// phases by the next walk rephase.  A satisfying assignment is also a
+// model of all later irredundant and redundant clauses (which are all
+// implied by the snapshot) and thus is checked by deciding on it as saved
+// phases in 'walk_thread_model'.  Assumptions and constraints are ignored
+// by local search, thus the thread is only used without them.
+
+struct WalkThread {
+
+  Random random;
+  vector<int> literals;         // clauses each terminated by zero
+  vector<unsigned> start;       // clause offsets in 'literals'
+  vector<vector<unsigned>> occs;        // clauses per literal
+  vector<unsigned> sat;         // number of satisfied literals per clause
+  vector<unsigned> broken;      // currently unsatisfied clauses
+  vector<unsigned> pos;         // position of a clause in 'broken'
+  vector<signed char> vals;     // current assignment of external variables
+  vector<double> table;         // break value to score table
+  vector<double> scores;        // scores of candidate literals
+  double epsilon;               // smallest considered score
+
+  std::mutex mutex;             // protects 'best' and 'minimum'
+  vector<signed char> best;     // assignment with fewest broken clauses
+  size_t minimum;
+  std::atomic<bool> stop, found;
+  std::atomic<int64_t> flips;
+  std::thread thread;
+
+  unsigned occ (int lit) const { return 2u*abs (lit) + (lit < 0); }
+  bool satisfies (int lit) const { return vals[abs (lit)] == sign (lit); }
+
+  unsigned break_value (int lit) const {
+    unsigned res = 0;
+    for (auto c : occs[occ (-lit)])
+      if (sat[c] == 1) res++;
+    return res;
+  }
+
+  void make (unsigned c) {
+    const unsigned last = broken.back ();
+    broken[pos[c]] = last, pos[last] = pos[c];
+    broken.pop_back ();
+  }
+
+  void brake (unsigned c) { pos[c] = broken.size (), broken.push_back (c); }
+
+  void flip (int lit) {
+    vals[abs (lit)] = sign (lit);
+    for (auto c : occs[occ (lit)])
+      if (!sat[c]++) make (c);
+    for (auto c : occs[occ (-lit)])
+      if (!--sat[c]) brake (c);
+  }
+
+  int pick_lit (unsigned c) {
+    double sum = 0;
+    const int * lits = &literals[start[c]];
+    for (const int * p = lits; *p; p++) {
+      const unsigned b = break_value (*p);
+      const double score = b < table.size () ? table[b] : epsilon;
+      scores.push_back (score);
+      sum += score;
+    }
+    const double lim = sum * random.generate_double ();
+    const int * p = lits;
+    auto j = scores.begin ();
+    sum = *j++;
+    while (sum <= lim && p[1]) sum += *j++, p++;
+    scores.clear ();
+    return *p;
+  }
+
+  void save_minimum () {
+    std::lock_guard<std::mutex> lock (mutex);
+    if (broken.size () >= minimum) return;
+    minimum = broken.size ();
+    best = vals;
+    if (!minimum) found = true;
+  }
+
+  void run () {
+    for (unsigned c = 0; c < start.size (); c++) {
+      for (const int * p = &literals[start[c]]; *p; p++)
+        if (satisfies (*p)) sat[c]++;
+      if (!sat[c]) brake (c);
+    }
+    save_minimum ();
+    int64_t count = 0;
+    while (!broken.empty () && !stop.load (std::memory_order_relaxed)) {
+      const unsigned c = broken[random.pick_int (0, broken.size () - 1)];
+      flip (pick_lit (c));
+      if (broken.size () < minimum) save_minimum ();
+      if (!(++count & 1023)) flips.store (count, std::memory_order_relaxed);
+    }
+    flips.store (count, std::memory_order_relaxed);
+  }
+
+  WalkThread (Internal * internal) :
+    random (internal->opts.seed), minimum (UINT_MAX),
+    stop (false), found (false), flips (0)
+  {
+    random += internal->stats.walk.count;
+    const int max_var = internal->external->max_var;
+    double size = 0;
+    for (const auto c : internal->clauses) {
+      if (c->garbage || c->redundant) continue;
+      bool satisfied = false;
+      const size_t first = literals.size ();
+      for (const auto lit : *c) {
+        const signed char tmp = internal->val (lit);
+        if (tmp > 0) { satisfied = true; break; }
+        if (!tmp) literals.push_back (internal->externalize (lit));
+      }
+      if (satisfied) { literals.resize (first); continue; }
+      size += literals.size () - first;
+      start.push_back (first);
+      literals.push_back (0);
+    }
+    occs.resize (2u*max_var + 2);
+    for (unsigned c = 0; c < start.size (); c++)
+      for (const int * p = &literals[start[c]]; *p; p++)
+        occs[occ (*p)].push_back (c);
+    sat.resize (start.size ());
+    pos.resize (start.size ());
+    vals.resize (max_var + 1);
+    for (int eidx = 1; eidx <= max_var; eidx++) {
+      const int ilit = internal->external->e2i[eidx];
+      int tmp = 0;
+      if (ilit) tmp = internal->val (ilit);
+      if (!tmp && ilit) tmp = sign (internal->phases.saved[abs (ilit)]);
+      if (!tmp) tmp = internal->opts.phase ? 1 : -1;
+      vals[eidx] = ilit < 0 ? -tmp : tmp;
+    }
+    const double cb = fitcbval (relative (size, start.size ()));
+    const double base = 1/cb;
+    double next = 1;
+    for (epsilon = next; next; next = epsilon*base)
+      table.push_back (epsilon = next);
+  }
+};
+
+void Internal::start_walk_thread () {
+  assert (!walkthread);
+  assert (!level);
+  if (!assumptions.empty () || !constraint.empty ()) return;
+  stats.walk.count++;
+  walkthread = new WalkThread (this);
+  PHASE ("walk", stats.walk.count,
+    "started concurrent local search on %zd clauses",
+    walkthread->start.size ());
+  WalkThread * w = walkthread;
+  walkthread->thread = std::thread ([w] () { w->run (); });
+}
+
+void Internal::import_walk_phases () {
+  assert (walkthread);
+  std::lock_guard<std::mutex> lock (walkthread->mutex);
+  if (walkthread->best.empty ()) return;
+  for (auto idx : vars) {
+    if (!active (idx)) continue;
+    const int elit = externalize (idx);
+    const signed char tmp = walkthread->best[abs (elit)];
+    phases.saved[idx] = elit < 0 ? -tmp : tmp;
+  }
+  if ((int64_t) walkthread->minimum < stats.walk.minimum)
+    stats.walk.minimum = walkthread->minimum;
+  PHASE ("walk", stats.walk.count,
+    "imported phases with %zd unsatisfied clauses",
+    walkthread->minimum);
+}
+
+bool Internal::walk_thread_found_model () {
+  return walkthread->found.load (std::memory_order_relaxed);
+}
+
+int Internal::walk_thread_model () {
+  import_walk_phases ();
+  stop_walk_thread ();
+  backtrack ();
+  if (!propagate ()) {
+    learn_empty_clause ();
+    return 20;
+  }
+  const int res = try_to_satisfy_formula_by_saved_phases ();
+  PHASE ("walk", stats.walk.count,
+    "concurrent local search model %s",
+    res == 10 ? "satisfies formula" : "not satisfying");
+  return res;
+}
+
+void Internal::stop_walk_thread () {
+  assert (walkthread);
+  walkthread->stop = true;
+  walkthread->thread.join ();
+  stats.walk.concurrent += walkthread->flips;
+  delete walkthread;
+  walkthread = 0;
+}
+
 }
@@ -3,20 +3,23 @@
 namespace CaDiCaL {
 
 void Internal::init_watches () {
-  assert (wtab.empty ());
+  assert (wtab.empty ()), assert (itab.empty ());
   if (wtab.size () < 2*vsize)
     wtab.resize (2*vsize, Watches ());
+  if (itab.size () < 2*vsize)
+    itab.resize (2*vsize, Watches ());
   LOG ("initialized watcher tables");
 }
 
 void Internal::clear_watches () {
   for (auto lit : lits)
-    watches (lit).clear ();
+    binaries (lit).clear (), watches (lit).clear ();
 }
 
 void Internal::reset_watches () {
   assert (!wtab.empty ());
   erase_vector (wtab);
+  erase_vector (itab);
   LOG ("reset watcher tables");
 }
 
@@ -70,29 +73,4 @@ void Internal::connect_watches (bool irredundant_only) {
   STOP (connect);
 }
 
-void Internal::sort_watches () {
-  assert (watching ());
-  LOG ("sorting watches");
-  Watches saved;
-  for (auto lit : lits) {
-    Watches & ws = watches (lit);
-
-    const const_watch_iterator end = ws.end ();
-    watch_iterator j = ws.begin ();
-    const_watch_iterator i;
-
-    assert (saved.empty ());
-
-    for (i = j; i != end; i++) {
-      const Watch w = *i;
-      if (w.binary ()) *j++ = w;
-      else saved.push_back (w);
-    }
-
-    std::copy (saved.cbegin (), saved.cend (), j);
-
-    saved.clear ();
-  }
-}
-
 }
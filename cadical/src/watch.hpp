@@ -7,25 +7,24 @@
 namespace CaDiCaL {
 
 // Watch lists for CDCL search.  The blocking literal (see also comments
-// related to 'propagate') is a must and thus combining that with a 64 bit
-// pointer will give a 16 byte (8 byte aligned) structure anyhow, which
-// means the additional 4 bytes for the size come for free.  As alternative
-// one could use a 32-bit reference instead of the pointer which would
-// however limit the number of clauses to '2^32 - 1'.  One would also need
-// to use at least one more bit (either taken away from the variable space
-// or the clauses) to denote whether the watch is binary.
-
-struct Clause;
+// related to 'propagate') is a must.  Combining it with a 64 bit pointer
+// would give a 16 byte (8 byte aligned) structure.  Instead we use a 32-bit
+// reference of the clause in the arena (see 'arena.hpp'), which halves
+// the memory of watches and the bandwidth needed to traverse them during
+// propagation.  The least significant bit of the reference denotes whether
+// the watch is binary, which is all what is needed from the clause size.
 
 struct Watch {
 
-  Clause * clause; int blit;
-  int size;
+  int blit;
+  unsigned ref;         // clause reference shifted by one and binary bit
 
-  Watch (int b, Clause * c) : clause (c), blit (b), size (c->size) { }
+  Watch (int b, unsigned r, bool binary) :
+    blit (b), ref ((r << 1) | binary) { }
   Watch () { }
 
-  bool binary () const { return size == 2; }
+  bool binary () const { return ref & 1; }
+  unsigned reference () const { return ref >> 1; }
 };
 
 typedef vector<Watch> Watches;          // of one literal
@@ -33,12 +32,12 @@ typedef vector<Watch> Watches;          // of one literal
 typedef Watches::iterator watch_iterator;
 typedef Watches::const_iterator const_watch_iterator;
 
-inline void remove_watch (Watches & ws, Clause * clause) {
+inline void remove_watch (Watches & ws, unsigned ref) {
   const auto end = ws.end ();
   auto i = ws.begin ();
   for (auto j = i; j != end; j++) {
     const Watch & w = *i++ = *j;
-    if (w.clause == clause) i--;
+    if (w.reference () == ref) i--;
   }
   assert (i + 1 == end);
   ws.resize (i - ws.begin ());
@@ -0,0 +1,324 @@
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+// Compression library headers (if found by 'configure').
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_LZMA
+#include <lzma.h>
+#endif
+
+#ifdef HAVE_BZLIB
+#include <bzlib.h>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+Zipper::Zipper (FILE * f) :
+  file (f), block (new char[block_size]),
+  eof (false), valid (false), failed (false)
+{
+  assert (f);
+}
+
+Zipper::~Zipper () { delete [] block; }
+
+size_t Zipper::read_block () {
+  if (eof) return 0;
+  const size_t res = fread (block, 1, block_size, file);
+  if (res < block_size) eof = true;
+  return res;
+}
+
+bool Zipper::write_block (size_t bytes) {
+  return !bytes || fwrite (block, 1, bytes, file) == bytes;
+}
+
+/*------------------------------------------------------------------------*/
+#ifdef HAVE_ZLIB
+
+// Reads 'gzip' files with multiple members as 'gzip -d' does.
+
+class GzipZipper : public Zipper {
+
+  z_stream stream;
+  bool writing;
+  bool pending;         // inside of a member
+
+public:
+
+  GzipZipper (FILE * f, bool w) : Zipper (f), writing (w), pending (false) {
+    memset (&stream, 0, sizeof stream);
+    if (writing)
+      valid = (deflateInit2 (&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                             15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    else
+      valid = (inflateInit2 (&stream, 15 + 32) == Z_OK);
+  }
+
+  ~GzipZipper () {
+    if (!valid) return;
+    if (writing) deflateEnd (&stream);
+    else inflateEnd (&stream);
+  }
+
+  long read (char * buffer, size_t size) {
+    assert (!writing);
+    if (failed) return -1;
+    stream.next_out = (Bytef *) buffer;
+    stream.avail_out = size;
+    while (!failed && stream.avail_out) {
+      if (!stream.avail_in) {
+        const size_t bytes = read_block ();
+        if (!bytes) { failed = pending; break; }
+        stream.next_in = (Bytef *) block;
+        stream.avail_in = bytes;
+      }
+      pending = true;
+      const int res = inflate (&stream, Z_NO_FLUSH);
+      if (res == Z_STREAM_END) {
+        failed = (inflateReset (&stream) != Z_OK);
+        pending = false;
+      } else if (res != Z_OK) failed = true;
+    }
+    const long res = size - stream.avail_out;
+    return (failed && !res) ? -1 : res;
+  }
+
+  bool write (const char * buffer, size_t size) {
+    assert (writing);
+    stream.next_in = (Bytef *) buffer;
+    stream.avail_in = size;
+    while (stream.avail_in) {
+      stream.next_out = (Bytef *) block;
+      stream.avail_out = block_size;
+      if (deflate (&stream, Z_NO_FLUSH) == Z_STREAM_ERROR) return false;
+      if (!write_block (block_size - stream.avail_out)) return false;
+    }
+    return true;
+  }
+
+  bool finish () {
+    assert (writing);
+    int res;
+    do {
+      stream.next_out = (Bytef *) block;
+      stream.avail_out = block_size;
+      res = deflate (&stream, Z_FINISH);
+      if (res != Z_OK && res != Z_STREAM_END) return false;
+      if (!write_block (block_size - stream.avail_out)) return false;
+    } while (res != Z_STREAM_END);
+    return true;
+  }
+};
+
+#endif
+/*------------------------------------------------------------------------*/
+#ifdef HAVE_LZMA
+
+// Handles '.xz' files (with concatenated streams as 'xz -d') and legacy
+// '.lzma' files for reading, but only '.xz' files for writing.
+
+class LzmaZipper : public Zipper {
+
+  lzma_stream stream;
+  lzma_action action;
+  bool writing;
+  bool finished;        // end of stream reached
+
+public:
+
+  LzmaZipper (FILE * f, bool w, bool alone) :
+    Zipper (f), action (LZMA_RUN), writing (w), finished (false)
+  {
+    const lzma_stream init = LZMA_STREAM_INIT;
+    stream = init;
+    lzma_ret res;
+    if (writing) res = lzma_easy_encoder (&stream, 6, LZMA_CHECK_CRC64);
+    else if (alone) res = lzma_alone_decoder (&stream, UINT64_MAX);
+    else res = lzma_stream_decoder (&stream, UINT64_MAX, LZMA_CONCATENATED);
+    valid = (res == LZMA_OK);
+  }
+
+  ~LzmaZipper () { lzma_end (&stream); }
+
+  long read (char * buffer, size_t size) {
+    assert (!writing);
+    if (failed) return -1;
+    if (finished) return 0;
+    stream.next_out = (uint8_t *) buffer;
+    stream.avail_out = size;
+    while (!failed && stream.avail_out) {
+      if (!stream.avail_in && action == LZMA_RUN) {
+        const size_t bytes = read_block ();
+        if (bytes) {
+          stream.next_in = (const uint8_t *) block;
+          stream.avail_in = bytes;
+        } else action = LZMA_FINISH;
+      }
+      const lzma_ret res = lzma_code (&stream, action);
+      if (res == LZMA_STREAM_END) { finished = true; break; }
+      if (res != LZMA_OK) failed = true;
+    }
+    const long res = size - stream.avail_out;
+    return (failed && !res) ? -1 : res;
+  }
+
+  bool write (const char * buffer, size_t size) {
+    assert (writing);
+    stream.next_in = (const uint8_t *) buffer;
+    stream.avail_in = size;
+    while (stream.avail_in) {
+      stream.next_out = (uint8_t *) block;
+      stream.avail_out = block_size;
+      if (lzma_code (&stream, LZMA_RUN) != LZMA_OK) return false;
+      if (!write_block (block_size - stream.avail_out)) return false;
+    }
+    return true;
+  }
+
+  bool finish () {
+    assert (writing);
+    lzma_ret res;
+    do {
+      stream.next_out = (uint8_t *) block;
+      stream.avail_out = block_size;
+      res = lzma_code (&stream, LZMA_FINISH);
+      if (res != LZMA_OK && res != LZMA_STREAM_END) return false;
+      if (!write_block (block_size - stream.avail_out)) return false;
+    } while (res != LZMA_STREAM_END);
+    return true;
+  }
+};
+
+#endif
+/*------------------------------------------------------------------------*/
+#ifdef HAVE_BZLIB
+
+// Reads 'bzip2' files with multiple streams as 'bzip2 -d' does.
+
+class Bzip2Zipper : public Zipper {
+
+  bz_stream stream;
+  bool writing;
+  bool pending;         // inside of a stream
+
+public:
+
+  Bzip2Zipper (FILE * f, bool w) : Zipper (f), writing (w), pending (false)
+  {
+    memset (&stream, 0, sizeof stream);
+    if (writing) valid = (BZ2_bzCompressInit (&stream, 9, 0, 0) == BZ_OK);
+    else valid = (BZ2_bzDecompressInit (&stream, 0, 0) == BZ_OK);
+  }
+
+  ~Bzip2Zipper () {
+    if (!valid) return;
+    if (writing) BZ2_bzCompressEnd (&stream);
+    else BZ2_bzDecompressEnd (&stream);
+  }
+
+  long read (char * buffer, size_t size) {
+    assert (!writing);
+    if (failed) return -1;
+    stream.next_out = buffer;
+    stream.avail_out = size;
+    while (!failed && stream.avail_out) {
+      if (!stream.avail_in) {
+        const size_t bytes = read_block ();
+        if (!bytes) { failed = pending; break; }
+        stream.next_in = block;
+        stream.avail_in = bytes;
+      }
+      pending = true;
+      const int res = BZ2_bzDecompress (&stream);
+      if (res == BZ_STREAM_END) {
+        char * next_in = stream.next_in;
+        const unsigned avail_in = stream.avail_in;
+        char * next_out = stream.next_out;
+        const unsigned avail_out = stream.avail_out;
+        BZ2_bzDecompressEnd (&stream);
+        memset (&stream, 0, sizeof stream);
+        valid = (BZ2_bzDecompressInit (&stream, 0, 0) == BZ_OK);
+        stream.next_in = next_in;
+        stream.avail_in = avail_in;
+        stream.next_out = next_out;
+        stream.avail_out = avail_out;
+        if (!valid) { failed = true; break; }
+        pending = false;
+      } else if (res != BZ_OK) failed = true;
+    }
+    const long res = size - stream.avail_out;
+    return (failed && !res) ? -1 : res;
+  }
+
+  bool write (const char * buffer, size_t size) {
+    assert (writing);
+    stream.next_in = (char *) buffer;
+    stream.avail_in = size;
+    while (stream.avail_in) {
+      stream.next_out = block;
+      stream.avail_out = block_size;
+      if (BZ2_bzCompress (&stream, BZ_RUN) != BZ_RUN_OK) return false;
+      if (!write_block (block_size - stream.avail_out)) return false;
+    }
+    return true;
+  }
+
+  bool finish () {
+    assert (writing);
+    int res;
+    do {
+      stream.next_out = block;
+      stream.avail_out = block_size;
+      res = BZ2_bzCompress (&stream, BZ_FINISH);
+      if (res != BZ_FINISH_OK && res != BZ_STREAM_END) return false;
+      if (!write_block (block_size - stream.avail_out)) return false;
+    } while (res != BZ_STREAM_END);
+    return true;
+  }
+};
+
+#endif
+/*------------------------------------------------------------------------*/
+
+bool Zipper::supports (const char * path) {
+#ifdef HAVE_ZLIB
+  if (has_suffix (path, ".gz")) return true;
+#endif
+#ifdef HAVE_LZMA
+  if (has_suffix (path, ".xz")) return true;
+  if (has_suffix (path, ".lzma")) return true;
+#endif
+#ifdef HAVE_BZLIB
+  if (has_suffix (path, ".bz2")) return true;
+#endif
+  (void) path;
+  return false;
+}
+
+Zipper * Zipper::open (FILE * file, const char * path, bool writing) {
+  Zipper * res = 0;
+#ifdef HAVE_ZLIB
+  if (has_suffix (path, ".gz")) res = new GzipZipper (file, writing);
+#endif
+#ifdef HAVE_LZMA
+  if (has_suffix (path, ".xz")) res = new LzmaZipper (file, writing, false);
+  if (has_suffix (path, ".lzma") && !writing)
+    res = new LzmaZipper (file, writing, true);
+#endif
+#ifdef HAVE_BZLIB
+  if (has_suffix (path, ".bz2")) res = new Bzip2Zipper (file, writing);
+#endif
+  (void) file, (void) path, (void) writing;
+  if (res && !res->valid) { delete res; res = 0; }
+  return res;
+}
+
+}
@@ -0,0 +1,66 @@
+#ifndef _zipper_hpp_INCLUDED
+#define _zipper_hpp_INCLUDED
+
+#include <cstdio>
+
+namespace CaDiCaL {
+
+// In-process streaming compression and decompression of files through
+// 'zlib', 'liblzma' and 'libbz2', which 'configure' enables by defining
+// 'HAVE_ZLIB', 'HAVE_LZMA' and 'HAVE_BZLIB' if it finds these libraries.
+// For all other compressed files 'File' still opens pipes to external
+// utilities.  The compressed data is read and written in large blocks
+// through the underlying 'FILE' while 'File' keeps another large block of
+// uncompressed characters (see 'File::fill' and 'File::flush_buffer').
+
+class Zipper {
+
+protected:
+
+  FILE * file;          // compressed data
+  char * block;         // buffer for compressed data
+  bool eof;             // no more compressed data to read
+  bool valid;           // initialization succeeded
+  bool failed;          // decompression failed
+
+  static const size_t block_size = 1 << 20;
+
+  Zipper (FILE *);
+
+  // Read the next block of compressed data and return its size.
+  //
+  size_t read_block ();
+
+  // Write 'bytes' compressed bytes from 'block'.
+  //
+  bool write_block (size_t bytes);
+
+public:
+
+  virtual ~Zipper ();
+
+  // Can files with this path name be (de)compressed in-process?
+  //
+  static bool supports (const char * path);
+
+  // Returns zero if 'supports (path)' is false or initialization failed.
+  //
+  static Zipper * open (FILE *, const char * path, bool writing);
+
+  // Decompress up to 'size' characters into 'buffer'.  The result is the
+  // number of characters decompressed, which is only smaller than 'size'
+  // at the end of the file, or negative if decompression failed (after the
+  // characters decompressed before the failure have been returned).
+  //
+  virtual long read (char * buffer, size_t size) = 0;
+
+  // Compress 'size' characters from 'buffer'.  At the end 'finish' has
+  // to be called to write the remaining compressed data.
+  //
+  virtual bool write (const char * buffer, size_t size) = 0;
+  virtual bool finish () = 0;
+};
+
+}
+
+#endif
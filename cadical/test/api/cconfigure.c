@@ -0,0 +1,59 @@
+#include "../../src/ipasir.h"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <assert.h>
+
+static const int n = 7;
+
+static int ph (int p, int h) {
+  assert (0 <= p), assert (p < n + 1);
+  assert (0 <= h), assert (h < n);
+  return 1 + h * (n+1) + p;
+}
+
+// Pigeon hole formula for 'pigeons' pigeons in 'n' holes.
+//
+static void formula (void * solver, int pigeons)
+{
+  for (int h = 0; h < n; h++)
+    for (int p1 = 0; p1 < pigeons; p1++)
+      for (int p2 = p1 + 1; p2 < pigeons; p2++)
+	ipasir_add (solver, -ph (p1, h)),
+	ipasir_add (solver, -ph (p2, h)),
+	ipasir_add (solver, 0);
+
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < n; h++)
+      ipasir_add (solver, ph (p, h));
+    ipasir_add (solver, 0);
+  }
+}
+
+// Every preset (and seed) must give the same answers.
+
+int main () {
+  const char * presets[] = { "default", "plain", "sat", "unsat" };
+  for (int i = 0; i < 4; i++) {
+    void * solver = ipasir_init ();
+    assert (ipasir_configure (solver, presets[i]));
+    ipasir_set_option (solver, "seed", i);
+    formula (solver, n);
+    assert (ipasir_solve (solver) == 10);
+    ipasir_release (solver);
+
+    solver = ipasir_init ();
+    assert (ipasir_configure (solver, presets[i]));
+    formula (solver, n + 1);
+    assert (ipasir_solve (solver) == 20);
+    ipasir_release (solver);
+  }
+
+  void * solver = ipasir_init ();
+  assert (!ipasir_configure (solver, "no-such-preset"));
+  ipasir_release (solver);
+
+  return 0;
+}
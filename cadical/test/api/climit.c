@@ -0,0 +1,78 @@
+#include "../../src/ccadical.h"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <assert.h>
+
+static const int n = 11;
+
+static int ph (int p, int h) {
+  assert (0 <= p), assert (p < n + 1);
+  assert (0 <= h), assert (h < n);
+  return 1 + h * (n+1) + p;
+}
+
+// Construct a pigeon hole formula for 'n+1' pigeons in 'n' holes.
+//
+static void formula (CCaDiCaL * solver)
+{
+  for (int h = 0; h < n; h++)
+    for (int p1 = 0; p1 < n + 1; p1++)
+      for (int p2 = p1 + 1; p2 < n + 1; p2++)
+	ccadical_add (solver, -ph (p1, h)),
+	ccadical_add (solver, -ph (p2, h)),
+	ccadical_add (solver, 0);
+
+  for (int p = 0; p < n + 1; p++) {
+    for (int h = 0; h < n; h++)
+      ccadical_add (solver, ph (p, h));
+    ccadical_add (solver, 0);
+  }
+}
+
+int main () {
+
+  CCaDiCaL * solver = ccadical_init ();
+  formula (solver);
+
+  // The conflict limit applies to every 'solve' call.
+  //
+  ccadical_set_conflict_limit (solver, 100);
+  assert (!ccadical_solve (solver));
+  assert (!ccadical_solve (solver));
+  ccadical_set_conflict_limit (solver, -1);
+
+  ccadical_set_decision_limit (solver, 100);
+  assert (!ccadical_solve (solver));
+  ccadical_set_decision_limit (solver, -1);
+
+  // The deadline is checked natively during search.
+  //
+  ccadical_set_time_limit (solver, 0.1);
+  assert (!ccadical_solve (solver));
+  assert (!ccadical_solve (solver));
+  ccadical_set_time_limit (solver, 0);
+
+  // The interrupt flag stays set until cleared.
+  //
+  ccadical_set_interrupt (solver, 1);
+  assert (!ccadical_solve (solver));
+  assert (!ccadical_solve (solver));
+  ccadical_set_interrupt (solver, 0);
+
+  ccadical_release (solver);
+
+  // Without any limit a satisfiable formula is solved as usual.
+  //
+  solver = ccadical_init ();
+  ccadical_set_time_limit (solver, 10);
+  ccadical_add (solver, 1), ccadical_add (solver, 2), ccadical_add (solver, 0);
+  ccadical_add (solver, -1), ccadical_add (solver, 0);
+  assert (ccadical_solve (solver) == 10);
+  assert (ccadical_val (solver, 2) == 2);
+  ccadical_release (solver);
+
+  return 0;
+}
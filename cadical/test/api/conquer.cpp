@@ -0,0 +1,53 @@
+#include "../../src/conquer.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+using namespace CaDiCaL;
+
+// Pigeon hole formula with 'n+1' pigeons and 'n' holes.
+
+static int ph (int p, int h, int n) { return p * n + h + 1; }
+
+static void pigeons (Solver & solver, int n) {
+  for (int p = 0; p <= n; p++) {
+    for (int h = 0; h < n; h++) solver.add (ph (p, h, n));
+    solver.add (0);
+  }
+  for (int h = 0; h < n; h++)
+    for (int p = 0; p <= n; p++)
+      for (int q = p + 1; q <= n; q++)
+        solver.add (-ph (p, h, n)), solver.add (-ph (q, h, n)),
+        solver.add (0);
+}
+
+int main () {
+  {
+    Solver original;
+    pigeons (original, 7);
+    Conquer conquer (original, 4, 3, 20);   // Small budget to split.
+    assert (conquer.threads () == 4);
+    int res = conquer.solve ();
+    assert (res == 20);
+    assert (conquer.solved_by () < 0);
+  }
+  {
+    Solver original;
+    for (int i = 1; i < 100; i++)
+      original.add (-i), original.add (i + 1), original.add (0);
+    Conquer conquer (original, 2, 2);
+    conquer.add (1), conquer.add (0);
+    int res = conquer.solve ();
+    assert (res == 10);
+    for (int i = 1; i <= 100; i++) assert (conquer.val (i) > 0);
+    conquer.add (-100), conquer.add (0);
+    res = conquer.solve ();
+    assert (res == 20);
+  }
+  return 0;
+}
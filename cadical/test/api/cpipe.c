@@ -0,0 +1,96 @@
+#include "../../src/ccadical.h"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <assert.h>
+
+static const int n = 6;
+
+static int ph (int p, int h) {
+  assert (0 <= p), assert (p < n + 1);
+  assert (0 <= h), assert (h < n);
+  return 1 + h * (n+1) + p;
+}
+
+// Literals are written into the segments of the pipe, which are small so
+// that clauses span segments and the ring wraps around several times.
+
+static const int segments = 3, size = 5;
+
+static CCaDiCaL * solver;
+static int * ring, segment = -1, written;
+
+static void add (int lit) {
+  if (segment < 0)
+    segment = ccadical_pipe_acquire (solver), written = 0;
+  ring[segment * size + written++] = lit;
+  if (written == size)
+    ccadical_pipe_submit (solver, segment, written), segment = -1;
+}
+
+static void submit (void) {
+  if (segment >= 0)
+    ccadical_pipe_submit (solver, segment, written), segment = -1;
+}
+
+static void flush (void) {
+  submit ();
+  ccadical_pipe_flush (solver);
+}
+
+// Pigeon hole formula for 'n+1' pigeons in 'n' holes.
+//
+static void formula (void)
+{
+  for (int h = 0; h < n; h++)
+    for (int p1 = 0; p1 < n + 1; p1++)
+      for (int p2 = p1 + 1; p2 < n + 1; p2++)
+	add (-ph (p1, h)), add (-ph (p2, h)), add (0);
+
+  for (int p = 0; p < n; p++) {
+    for (int h = 0; h < n; h++)
+      add (ph (p, h));
+    add (0);
+  }
+}
+
+int main () {
+
+  solver = ccadical_init ();
+  ring = ccadical_pipe_open (solver, segments, size);
+  assert (ring);
+  assert (ccadical_pipe_open (solver, segments, size) == ring);
+
+  // Without the clause of the last pigeon the formula is satisfiable.
+  //
+  formula ();
+  flush ();
+  assert (ccadical_solve (solver) == 10);
+  for (int p = 0; p < n; p++) {
+    int holes = 0;
+    for (int h = 0; h < n; h++)
+      holes += ccadical_val (solver, ph (p, h)) > 0;
+    assert (holes == 1);
+  }
+
+  // Submitted literals are added before those of 'ccadical_add'.
+  //
+  for (int h = 0; h < n; h++)
+    add (ph (n, h));
+  submit ();
+  ccadical_add (solver, 0);
+  assert (ccadical_solve (solver) == 20);
+
+  ccadical_release (solver);
+
+  // Releasing a solver with literals in the pipe stops its thread.
+  //
+  solver = ccadical_init ();
+  ring = ccadical_pipe_open (solver, segments, size);
+  formula ();
+  ccadical_release (solver);
+
+  return 0;
+}
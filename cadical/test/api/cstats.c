@@ -0,0 +1,49 @@
+#include "../../src/ipasir.h"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+
+static const int n = 6;
+
+static int ph (int p, int h) {
+  assert (0 <= p), assert (p < n + 1);
+  assert (0 <= h), assert (h < n);
+  return 1 + h * (n+1) + p;
+}
+
+// Counters start at zero, grow while solving an unsatisfiable pigeon hole
+// formula and unknown names give '-1'.
+
+int main () {
+  void * solver = ipasir_init ();
+  assert (!ipasir_get_statistic (solver, "conflicts"));
+  assert (ipasir_get_statistic (solver, "no-such-counter") == -1);
+
+  for (int h = 0; h < n; h++)
+    for (int p1 = 0; p1 < n + 1; p1++)
+      for (int p2 = p1 + 1; p2 < n + 1; p2++)
+	ipasir_add (solver, -ph (p1, h)),
+	ipasir_add (solver, -ph (p2, h)),
+	ipasir_add (solver, 0);
+
+  for (int p = 0; p < n + 1; p++) {
+    for (int h = 0; h < n; h++)
+      ipasir_add (solver, ph (p, h));
+    ipasir_add (solver, 0);
+  }
+  assert (ipasir_solve (solver) == 20);
+
+  int64_t conflicts = ipasir_get_statistic (solver, "conflicts");
+  assert (conflicts > 0);
+  assert (ipasir_get_statistic (solver, "decisions") > 0);
+  assert (ipasir_get_statistic (solver, "propagations") >= conflicts);
+  assert (ipasir_get_statistic (solver, "restarts") >= 0);
+  assert (ipasir_get_statistic (solver, "maxmemory") > 0);
+  ipasir_release (solver);
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include "../../src/portfolio.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+using namespace CaDiCaL;
+
+// Pigeon hole formula with 'n+1' pigeons and 'n' holes.
+
+static int ph (int p, int h, int n) { return p * n + h + 1; }
+
+static void pigeons (Solver & solver, int n) {
+  for (int p = 0; p <= n; p++) {
+    for (int h = 0; h < n; h++) solver.add (ph (p, h, n));
+    solver.add (0);
+  }
+  for (int h = 0; h < n; h++)
+    for (int p = 0; p <= n; p++)
+      for (int q = p + 1; q <= n; q++)
+        solver.add (-ph (p, h, n)), solver.add (-ph (q, h, n)),
+        solver.add (0);
+}
+
+int main () {
+  {
+    Solver original;
+    pigeons (original, 7);
+    Portfolio portfolio (original, 4);
+    assert (portfolio.threads () == 4);
+    int res = portfolio.solve ();
+    assert (res == 20);
+    assert (0 <= portfolio.solved_by () && portfolio.solved_by () < 4);
+  }
+  {
+    Solver original;
+    for (int i = 1; i < 100; i++)
+      original.add (-i), original.add (i + 1), original.add (0);
+    original.add (1), original.add (0);
+    Portfolio portfolio (original, 2);
+    int res = portfolio.solve ();
+    assert (res == 10);
+    for (int i = 1; i <= 100; i++) assert (portfolio.val (i) > 0);
+    portfolio.add (-100), portfolio.add (0);
+    res = portfolio.solve ();
+    assert (res == 20);
+  }
+  return 0;
+}
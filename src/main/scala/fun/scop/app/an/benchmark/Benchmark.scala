@@ -0,0 +1,254 @@
+package fun.scop.app.an.benchmark
+
+import fun.scop.app.an.generator._
+import fun.scop.app.an.solver._
+import fun.scop.app.an.util._
+import fun.scop.sat._
+
+import java.io.{ByteArrayOutputStream, FileWriter, PrintStream, PrintWriter}
+import java.lang.management.{ManagementFactory, MemoryType}
+import java.util.Locale
+import scala.collection.JavaConverters._
+
+/* Runs every encoding with every available backend on generated networks
+ * (stars, random Boolean networks, chains of SCCs) and on the networks given
+ * as arguments, and appends one CSV row per run, so that the rows of two
+ * releases can be compared.
+ */
+object Benchmark {
+
+  var libname: Option[String] = None
+  var libpath: Option[String] = None
+  var k1solver: Option[String] = None
+  var k = 4
+  var timeout = 60.0
+  var scale = 1
+  var seed = 0L
+  var out = "benchmark.csv"
+
+  val encodings = Seq("basic", "symmetry", "cycle", "full")
+
+  val header = Seq(
+    "family",
+    "network",
+    "automata",
+    "transitions",
+    "backend",
+    "encoding",
+    "k",
+    "attractors",
+    "encode_s",
+    "solve_s",
+    "total_s",
+    "peak_heap_mb",
+    "solver_memory_mb",
+    "child_rss_mb",
+    "timeout"
+  )
+
+  case class Row(
+      family: String,
+      network: String,
+      an: AutomataNetwork,
+      backend: String,
+      encoding: String,
+      k: Int,
+      attractors: Int,
+      encodeTime: Double,
+      solveTime: Double,
+      totalTime: Double,
+      peakHeapMb: Long,
+      solverMemoryMb: Long,
+      childRssMb: Long,
+      timedOut: Boolean
+  ) {
+    def fields = Seq(
+      family,
+      network,
+      an.automatas.size,
+      an.transitions.size,
+      backend,
+      encoding,
+      k,
+      attractors,
+      "%.3f".formatLocal(Locale.ROOT, encodeTime),
+      "%.3f".formatLocal(Locale.ROOT, solveTime),
+      "%.3f".formatLocal(Locale.ROOT, totalTime),
+      peakHeapMb,
+      solverMemoryMb,
+      childRssMb,
+      timedOut
+    )
+  }
+
+  /* outcome of one run, memory in MB being -1 where it is not known */
+  case class Outcome(
+      k: Int,
+      attractors: Int,
+      encodeTime: Double,
+      solveTime: Double,
+      timedOut: Boolean,
+      solverMemoryMb: Long = -1,
+      childRssMb: Long = -1
+  )
+
+  def parseOptions(arguments: List[String]): List[String] = arguments match {
+    case "-libname" :: name :: rest => {
+      libname = Some(name)
+      parseOptions(rest)
+    }
+    case "-libpath" :: path :: rest => {
+      libpath = Some(path)
+      parseOptions(rest)
+    }
+    case "-k1solver" :: path :: rest => {
+      k1solver = Some(path)
+      parseOptions(rest)
+    }
+    case "-k" :: n :: rest => {
+      k = n.toInt
+      parseOptions(rest)
+    }
+    case "-timeout" :: sec :: rest => {
+      timeout = sec.toDouble
+      parseOptions(rest)
+    }
+    case "-scale" :: n :: rest => {
+      scale = n.toInt
+      parseOptions(rest)
+    }
+    case "-seed" :: n :: rest => {
+      seed = n.toLong
+      parseOptions(rest)
+    }
+    case "-out" :: path :: rest => {
+      out = path
+      parseOptions(rest)
+    }
+    case _ => arguments
+  }
+
+  def showOptions = {
+    println("\t-libname <Library Name>		: name of IPASIR Library (adds the CaDiCaL backend)")
+    println("\t-libpath <Library Path>		: directory where IPASIR Library is")
+    println("\t-k1solver <K1 Solver Path>		: path of bdd_minisat_all (adds the k=1 AllSAT backend)")
+    println("\t-k <INT>				: upper bound of k (default 4)")
+    println("\t-timeout <SEC>				: time limit for each k (default 60)")
+    println("\t-scale <INT>				: multiplies the sizes of the generated networks (default 1)")
+    println("\t-seed <INT>				: seed of the random networks (default 0)")
+    println("\t-out <File>				: CSV file the rows are appended to (default benchmark.csv)")
+  }
+
+  /* (family, name, network) of the generated networks */
+  def generated: Seq[(String, String, AutomataNetwork)] = {
+    val stars = for (n <- Seq(4, 6, 8, 10).map(_ * scale))
+      yield ("star", s"star-$n", starGenerator.generate(n))
+    val randoms = for (n <- Seq(10, 20, 30).map(_ * scale); inDegree <- Seq(2, 3))
+      yield ("random", s"random-$n-$inDegree-$seed", randomGenerator.generate(n, inDegree, seed))
+    val chains = for (m <- Seq(2, 4, 6).map(_ * scale))
+      yield ("chain", s"chain-$m-3", chainGenerator.generate(m, 3))
+    stars ++ randoms ++ chains
+  }
+
+  def backends: Seq[(String, () => SatSolver)] =
+    Seq(("sat4j", () => new Sat4j())) ++
+      (for (name <- libname; path <- libpath)
+        yield ("cadical", () => new PureIpasirSatSolver(name, path)))
+
+  private def heapPools =
+    ManagementFactory.getMemoryPoolMXBeans.asScala.filter(_.getType == MemoryType.HEAP)
+
+  private def measured(body: => Outcome) = {
+    System.gc()
+    heapPools.foreach(_.resetPeakUsage())
+    val (result, seconds) = StatsLog.timed(body)
+    val peak = heapPools.map(_.getPeakUsage.getUsed).sum >> 20
+    (result, seconds, peak)
+  }
+
+  /* searches k = 1, 2, ... as Saf does, stopping at the first timeout */
+  private def runSaf(
+      an: AutomataNetwork,
+      encoding: String,
+      satSolver: () => SatSolver
+  ) = {
+    val bound = an.stateSpaceSize.min(BigInt(k)).toInt
+    var foundSoFar = Seq.empty[Attractor]
+    var encodeTime, solveTime = 0.0
+    var timedOut = false
+    var reached = 0
+    var maxMemory = -1L
+    for (i <- (1 to bound).iterator.takeWhile(_ => !timedOut)) {
+      val sat = satSolver()
+      val solver = new Saf(an, encoding, sat, verbose = false, timeLimit = timeout)
+      try {
+        foundSoFar = solver.findAttractorsLeKApp(i, foundSoFar)
+        encodeTime += solver.encodeTime
+        solveTime += solver.solveTime + solver.blockTime
+        timedOut = solver.timedOut
+        reached = i
+        // peak resident set size as reported by CaDiCaL, in bytes
+        for (bytes <- sat.statistics.get("maxmemory"))
+          maxMemory = maxMemory.max(bytes >> 20)
+      } finally sat.release()
+    }
+    Outcome(reached, foundSoFar.size, encodeTime, solveTime, timedOut, maxMemory)
+  }
+
+  /* fixed points by the external AllSAT solver, its output is discarded */
+  private def runK1(an: AutomataNetwork, path: String) = {
+    val solver = new SafK1(an, path, verbose = false, measureMemory = true)
+    Console.withOut(new PrintStream(new ByteArrayOutputStream)) {
+      solver.findAttractorsLeK(1, Seq.empty)
+    }
+    Outcome(
+      1,
+      solver.solutions.min(Int.MaxValue).toInt,
+      solver.encodeTime,
+      solver.solveTime,
+      false,
+      childRssMb = if (solver.maxRss < 0) -1 else solver.maxRss >> 10
+    )
+  }
+
+  def run(family: String, name: String, an: AutomataNetwork): Seq[Row] = {
+    an.calcCycles()
+    val runs =
+      (for ((backend, satSolver) <- backends; encoding <- encodings)
+        yield (backend, encoding, () => runSaf(an, encoding, satSolver))) ++
+        k1solver.map(path => ("bdd_minisat_all", "k1", () => runK1(an, path)))
+
+    for ((backend, encoding, body) <- runs) yield {
+      val (outcome, total, peak) = measured(body())
+      val row = Row(family, name, an, backend, encoding, outcome.k,
+        outcome.attractors, outcome.encodeTime, outcome.solveTime, total, peak,
+        outcome.solverMemoryMb, outcome.childRssMb, outcome.timedOut)
+      println(row.fields.mkString(","))
+      row
+    }
+  }
+
+  def main(args: Array[String]): Unit = {
+    val inputs = parseOptions(args.toList)
+    if (inputs.exists(_.startsWith("-"))) {
+      println(s"Something wrong in arguments: ${args.mkString(" ")}")
+      println("Usage: java -cp saf.jar fun.scop.app.an.benchmark.Benchmark [options] [inputFile ...]")
+      showOptions
+      System.exit(1)
+    }
+
+    val networks = generated ++
+      inputs.map(file => ("input", file, Saf.getAN(file)))
+
+    val isNew = !new java.io.File(out).exists
+    val pw = new PrintWriter(new FileWriter(out, true))
+    if (isNew)
+      pw.println(header.mkString(","))
+    println(header.mkString(","))
+    for ((family, name, an) <- networks; row <- run(family, name, an)) {
+      pw.println(row.fields.mkString(","))
+      pw.flush()
+    }
+    pw.close()
+  }
+}
@@ -0,0 +1,65 @@
+package fun.scop.app.an.generator
+
+import fun.scop.app.an.util._
+import java.io.PrintWriter
+
+/* chains of m strongly connected components of size automata each: the
+ * automata of a component form a positive cycle, each copying the previous
+ * one, and the first automaton of a component also needs the last automaton
+ * of the component above it to become 1
+ */
+object chainGenerator {
+
+  def name(c: Int, k: Int) = s"C${c}_${k}"
+
+  def av(c: Int, k: Int, value: Int) = AutomataValued(Automata(name(c, k)), value)
+
+  def genAutomata(m: Int, size: Int) = {
+    for {
+      c <- 1 to m
+      k <- 1 to size
+    } yield Automata(name(c, k))
+  }
+
+  def genDomain(m: Int, size: Int) =
+    genAutomata(m, size).map(a => a -> Seq(0, 1)).toMap
+
+  def genTransition(m: Int, size: Int) = {
+    def previous(k: Int) = if (k == 1) size else k - 1
+
+    val ts01 = for {
+      c <- 1 to m
+      k <- 1 to size
+    } yield Transition(
+      av(c, k, 0),
+      av(c, k, 1),
+      av(c, previous(k), 1) +: (if (k == 1 && c > 1) Seq(av(c - 1, size, 1)) else Seq.empty)
+    )
+
+    // 1 -> 0 when the previous automaton is 0, or the upstream one for k = 1
+    val ts10 = for {
+      c <- 1 to m
+      k <- 1 to size
+      cond <- av(c, previous(k), 0) +: (if (k == 1 && c > 1) Seq(av(c - 1, size, 0)) else Seq.empty)
+    } yield Transition(av(c, k, 1), av(c, k, 0), Seq(cond))
+
+    ts01 ++ ts10
+  }
+
+  def generate(m: Int, size: Int) = {
+    require(size >= 2, "components need at least two automata")
+    AutomataNetwork(genAutomata(m, size), genDomain(m, size), genTransition(m, size))
+  }
+
+  def main(args: Array[String]) = {
+
+    val an = generate(args(0).toInt, args(1).toInt)
+
+    val pw = new PrintWriter(args(2))
+
+    pw.write(an.toAnFormat)
+
+    pw.close()
+
+  }
+}
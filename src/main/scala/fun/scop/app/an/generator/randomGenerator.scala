@@ -0,0 +1,58 @@
+package fun.scop.app.an.generator
+
+import fun.scop.app.an.util._
+import java.io.PrintWriter
+import scala.util.Random
+
+/* random Boolean networks of n automata, each with inDegree regulators
+ * (other automata) and a random update function given by its truth table
+ */
+object randomGenerator {
+
+  def name(k: Int) = s"R${k}"
+
+  def av(k: Int, value: Int) = AutomataValued(Automata(name(k)), value)
+
+  def genAutomata(n: Int) = {
+    for {
+      k <- 1 to n
+    } yield Automata(name(k))
+  }
+
+  def genDomain(n: Int) = {
+    (for {
+      k <- 1 to n
+    } yield Automata(name(k)) -> Seq(0, 1)).toMap
+  }
+
+  def genTransition(n: Int, inDegree: Int, random: Random) = {
+    for {
+      k <- 1 to n
+      regulators = random.shuffle((1 to n).filter(_ != k).toList).take(inDegree)
+      row <- 0 until (1 << regulators.size)
+      condition = regulators.zipWithIndex.map { case (r, i) =>
+        av(r, (row >> i) & 1)
+      }
+      value = random.nextInt(2) // of the function on the row
+    } yield Transition(av(k, 1 - value), av(k, value), condition)
+  }
+
+  def generate(n: Int, inDegree: Int, seed: Long) =
+    AutomataNetwork(
+      genAutomata(n),
+      genDomain(n),
+      genTransition(n, inDegree, new Random(seed))
+    )
+
+  def main(args: Array[String]) = {
+
+    val an = generate(args(0).toInt, args(1).toInt, args(2).toLong)
+
+    val pw = new PrintWriter(args(3))
+
+    pw.write(an.toAnFormat)
+
+    pw.close()
+
+  }
+}
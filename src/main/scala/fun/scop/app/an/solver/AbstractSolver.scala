@@ -3,6 +3,9 @@ package fun.scop.app.an.solver
 import fun.scop.app.an.util._
 
 abstract class AbstractSolver() {
+  /* set when the search for some k was cut by the time limit */
+  var timedOut = false
+
   def findAttractorsLeK(
       k: Int,
       attractorsFoundSoFar: Seq[Attractor]
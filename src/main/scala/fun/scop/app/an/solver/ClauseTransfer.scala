@@ -0,0 +1,86 @@
+package fun.scop.app.an.solver
+
+import fun.scop.app.an.util._
+import fun.scop.sat._
+
+/* Learned clauses over the variables of a single state of the k instance,
+ * kept across k when they follow from the constraints that every state of
+ * every instance with k >= 2 satisfies:
+ *   - the domain encoding of the automata,
+ *   - the definition of ti from the preconditions of the transitions,
+ *   - some transition can be fired,
+ *   - inactive transitions are not fired,
+ *   - the first state of every attractor found so far is blocked.
+ * Such clauses can be given to all states of the later instances.
+ */
+class ClauseTransfer(an: AutomataNetwork, val maxLength: Int = 8) {
+
+  private var nofVars = 0
+
+  private def newVar() = {
+    nofVars += 1
+    nofVars
+  }
+
+  /* variables of a single state, numbered independently of the instances */
+  val x: Map[(Automata, Int), Int] = an.automatas.flatMap { a =>
+    if (an.domain(a).size > 2)
+      an.domain(a).map(v => (a, v) -> newVar())
+    else {
+      val p = newVar()
+      Seq((a, 0) -> -p, (a, 1) -> p)
+    }
+  }.toMap
+
+  val ti: Map[Transition, Int] = an.transitions.map(tr => tr -> newVar()).toMap
+
+  private val checker = new Sat4j()
+  checker.sat4j.newVar(nofVars)
+
+  for (a <- an.automatas if an.domain(a).size > 2) {
+    val ps = an.domain(a).map(v => x(a, v))
+    checker.addClause(ps)
+    for (Seq(p, q) <- ps.combinations(2))
+      checker.addClause(Seq(-p, -q))
+  }
+  for (tr <- an.transitions) {
+    for (av <- tr.pre)
+      checker.addClause(Seq(-ti(tr), x(av.a, av.v)))
+    checker.addClause(ti(tr) +: tr.pre.map(av => -x(av.a, av.v)))
+  }
+  checker.addClause(an.transitions.map(ti))
+  if (an.isCycleComputed)
+    for (tr <- an.inactiveTransition)
+      checker.addClause(Seq(-ti(tr)))
+
+  private var blocked = Set.empty[GlobalState]
+  private var candidates = Set.empty[Seq[Int]]
+  private var tried = Set.empty[Seq[Int]]
+
+  /* clauses found valid so far, over the variables x and ti */
+  var clauses = Seq.empty[Seq[Int]]
+
+  def collect(clause: Seq[Int]) = {
+    val c = clause.distinct.sorted
+    if (!tried(c))
+      candidates += c
+  }
+
+  /* keeps the collected clauses which follow from the constraints above,
+   * attractors being those found up to the instance that learned them
+   */
+  def verify(attractors: Seq[Attractor]) = {
+    for (att <- attractors if !blocked(att.gs.head)) {
+      blocked += att.gs.head
+      checker.addClause(att.gs.head.avs.map(av => -x(av.a, av.v)))
+    }
+    for (c <- candidates) {
+      tried += c
+      if (checker.solve(c.map(-_)).contains(false))
+        clauses = clauses :+ c
+    }
+    candidates = Set.empty
+  }
+
+  override def toString = s"#Transferred: ${clauses.size}"
+}
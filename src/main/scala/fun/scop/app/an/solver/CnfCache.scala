@@ -0,0 +1,49 @@
+package fun.scop.app.an.solver
+
+import fun.scop.app.an.util._
+
+import java.io.{BufferedOutputStream, File, FileOutputStream}
+import java.nio.charset.StandardCharsets
+import java.security.MessageDigest
+
+/* Encoded instances stored in dir, one file per (network, k, encoding)
+ * named after the SHA-256 of the network in .an format (so that networks
+ * read from other formats share the entry), k and the encoding.  Files are
+ * in the binary 'p bcnf' format read by CaDiCaL and bdd_minisat_all:
+ * literals as 2*|lit| + (lit < 0) in 7-bit chunks, clauses ending with 0.
+ */
+class CnfCache(dir: String) {
+
+  new File(dir).mkdirs()
+
+  def file(an: AutomataNetwork, k: Int, encoding: String): File = {
+    val digest = MessageDigest.getInstance("SHA-256")
+    digest.update(an.toAnFormat.getBytes(StandardCharsets.UTF_8))
+    digest.update(s"\nk=$k\nencoding=$encoding\n".getBytes(StandardCharsets.UTF_8))
+    val key = digest.digest.map(b => f"${b & 0xff}%02x").mkString
+    new File(dir, s"$key.bcnf")
+  }
+
+  /* written to a temporary file first, so that a concurrent run never reads
+   * a partial entry
+   */
+  def write(file: File, nofVars: Int, clauses: Seq[Seq[Int]]): Unit = {
+    val tmp = File.createTempFile(file.getName, ".tmp", file.getParentFile)
+    val out = new BufferedOutputStream(new FileOutputStream(tmp), 1 << 16)
+    out.write(s"p bcnf $nofVars ${clauses.size}\n".getBytes(StandardCharsets.US_ASCII))
+    for (lits <- clauses) {
+      for (lit <- lits) {
+        var code = 2L * math.abs(lit.toLong) + (if (lit < 0) 1 else 0)
+        while (code >= 0x80) {
+          out.write(((code & 0x7f) | 0x80).toInt)
+          code >>>= 7
+        }
+        out.write(code.toInt)
+      }
+      out.write(0)
+    }
+    out.close()
+    if (!tmp.renameTo(file))
+      tmp.delete()
+  }
+}
@@ -7,16 +7,28 @@ import fun.scop.sat._
 class SafK1(
     an: AutomataNetwork,
     solverpath: String,
-    verbose: Boolean = true
+    verbose: Boolean = true,
+    cache: Option[CnfCache] = None,
+    measureMemory: Boolean = false
 ) extends AbstractSolver() {
 
   var dimacsIndex = 0
   var nofClauses = 0
 
+  /* seconds spent in encoding (and writing the file) and in the solver */
+  var encodeTime = 0.0
+  var solveTime = 0.0
+
+  /* fixed points counted by the solver, -1 if it did not report them */
+  var solutions = -1L
+
+  /* peak resident set size of the solver process in kB, -1 if unknown */
+  var maxRss = -1L
+
   var xx: Map[(Automata, Int, Int), Int] = Map.empty
   var dmap: Map[Int, String] = Map.empty
 
-  var clauses: Seq[String] = Seq.empty
+  var clauses: Seq[Seq[Int]] = Seq.empty
 
   private def issueAuxVar() = {
     dimacsIndex += 1
@@ -62,7 +74,7 @@ class SafK1(
       } yield str
     }
     nofClauses += 1
-    clauses = s"${lits.mkString(" ")} 0" +: clauses
+    clauses = lits +: clauses
   }
 
   private def makeIntVarEncoding(k: Int) = {
@@ -96,20 +108,44 @@ class SafK1(
     val out = new PrintWriter(file)
     out.write(s"p cnf ${dimacsIndex} ${nofClauses}\n")
     for (lits <- clauses)
-      out.write(lits + "\n")
+      out.write(s"${lits.mkString(" ")} 0\n")
     out.close()
 
   }
 
-  private def execSolver(file: String) = {
-    import scala.sys.process.Process
+  /* runs the solver on file, which is deleted afterwards if deleteAfter is
+   * set and the solver succeeded (cached instances are kept)
+   */
+  private def execSolver(file: String, deleteAfter: Boolean) = {
+    import scala.sys.process.{Process, ProcessLogger}
 
-    val process = Process(
-      s"$solverpath $file ${if (verbose) "out" else ""}"
-    ).run
+    val timing = SafK1.time match {
+      case Some(time) if measureMemory => s"$time -f ${SafK1.rssTag}%M "
+      case _                           => ""
+    }
 
-    if (process.exitValue() == 0) {
-      Process(s"rm $file")
+    // BDD_MINISAT_ALL ends with "SAT (full)        : <count>"
+    val logger = ProcessLogger(
+      line => {
+        val count = line.dropWhile(!_.isDigit).takeWhile(_.isDigit)
+        if (line.startsWith("SAT (full)") && count.nonEmpty)
+          solutions = count.toLong
+        println(line)
+      },
+      line =>
+        if (timing.nonEmpty && line.startsWith(SafK1.rssTag))
+          maxRss = line.drop(SafK1.rssTag.size).trim.toLong
+        else System.err.println(line)
+    )
+    val (exitValue, seconds) = StatsLog.timed(
+      Process(
+        s"$timing$solverpath $file ${if (verbose) "out" else ""}"
+      ).!(logger)
+    )
+    solveTime += seconds
+
+    if (exitValue == 0 && deleteAfter) {
+      new java.io.File(file).delete()
       // println("Exit 0.")
     }
   }
@@ -119,19 +155,43 @@ class SafK1(
       attractorsFoundSoFar: Seq[Attractor]
   ): Seq[Attractor] = {
 
-    encode(k, attractorsFoundSoFar)
-
     val tmpFile = "/tmp/tmp.cnf"
 
-    makeFile(tmpFile)
+    // a cached instance is given as is to the solver, without encoding
+    val ((file, deleteAfter), seconds) = StatsLog.timed(cache match {
+      case Some(c) => {
+        val cached = c.file(an, k, "k1")
+        if (!cached.exists) {
+          encode(k, attractorsFoundSoFar)
+          c.write(cached, dimacsIndex, clauses)
+        }
+        (cached.getPath, false)
+      }
+      case None => {
+        encode(k, attractorsFoundSoFar)
+        makeFile(tmpFile)
+        (tmpFile, true)
+      }
+    })
+    encodeTime += seconds
 
     // for (i <- dmap.keys.toSeq.sorted) {
 
     //   println(s"$i: ${dmap(i)}")
     // }
-    execSolver(tmpFile)
+    execSolver(file, deleteAfter)
 
     Seq.empty
   }
 
 }
+
+object SafK1 {
+
+  /* GNU time, which reports the peak resident set size of the solver */
+  val time =
+    Some("/usr/bin/time").filter(path =>
+      sys.props("os.name") == "Linux" && new java.io.File(path).canExecute
+    )
+  val rssTag = "saf-maxrss="
+}
@@ -0,0 +1,85 @@
+package fun.scop.app.an.solver
+
+import fun.scop.app.an.util._
+import fun.scop.sat._
+
+/* Attractors computed module by module, a module being a strongly connected
+ * component of the interaction graph.  Modules are solved upstream first; a
+ * downstream module is solved once per attractor of the automata above it,
+ * by SAT after substituting the upstream values when that attractor is a
+ * fixed point, and by explicit composition otherwise.
+ */
+class ModularSolver(
+    an: AutomataNetwork,
+    maxK: Int,
+    satSolver: () => SatSolver,
+    maxProductSize: Int = 1 << 16
+) {
+
+  /* b -> automata having a transition conditioned on b */
+  lazy val interactionGraph: Map[Automata, Seq[Automata]] =
+    an.transitions
+      .flatMap(t => t.condition.map(_.a).filter(_ != t.target).map(_ -> t.target))
+      .distinct
+      .groupBy(_._1)
+      .map { case (b, edges) => b -> edges.map(_._2) }
+
+  /* strongly connected components, upstream modules first */
+  lazy val modules: Seq[Seq[Automata]] = {
+    val position = an.automatas.zipWithIndex.toMap
+    StateGraph
+      .sccs(an.automatas, (a: Automata) => interactionGraph.getOrElse(a, Seq.empty))
+      .reverse
+      .map(_.sortBy(position))
+  }
+
+  def findAttractors: Seq[Attractor] = {
+    var partial: Seq[Seq[Map[Automata, Int]]] = Seq(Seq(Map.empty))
+    var upstream = Seq.empty[Transition]
+
+    for (module <- modules) {
+      val ts = module.flatMap(an.transitionsOf)
+      val extended = partial.map(att => extend(att, module, ts, upstream))
+      if (extended.exists(_.isEmpty)) {
+        println(s"Module ${module.map(_.name).mkString("{", ",", "}")} " +
+          "is too large to compose, solving the whole network")
+        return Saf.findAllAttractors(an, maxK, satSolver)
+      }
+      partial = extended.flatMap(_.get)
+      upstream = upstream ++ ts
+    }
+
+    partial.map(states => Attractor(states.map(s => GlobalState.fromMap(an, s))))
+  }
+
+  private def extend(
+      att: Seq[Map[Automata, Int]],
+      module: Seq[Automata],
+      ts: Seq[Transition],
+      upstream: Seq[Transition]
+  ): Option[Seq[Seq[Map[Automata, Int]]]] = {
+    if (att.size == 1) {
+      val s = att.head
+      val sub = AutomataNetwork(
+        module,
+        module.map(a => a -> an.domain(a)).toMap,
+        NetworkReduction.substitute(ts, s)
+      )
+      Some(
+        Saf.findAllAttractors(sub, maxK, satSolver).map(b => b.gs.map(g => s ++ g.avMap))
+      )
+    } else {
+      val size = BigInt(att.size) * module.map(a => BigInt(an.domain(a).size)).product
+      if (size > maxProductSize)
+        None
+      else {
+        val product = for {
+          s <- att
+          vs <- NetworkReduction.valuations(an, module)
+        } yield s ++ vs
+        Some(StateGraph.terminalSccs(product, NetworkReduction.successors(upstream ++ ts)))
+      }
+    }
+  }
+
+}
@@ -2,12 +2,26 @@ package fun.scop.app.an.solver
 
 import fun.scop.app.an.util._
 import fun.scop.sat._
+import fun.scop.sim.NativeSimulator
+
+import java.io.{ByteArrayOutputStream, PrintStream}
+import java.util.concurrent.Executors
+import java.util.concurrent.atomic.AtomicInteger
+import scala.concurrent.{Await, ExecutionContext, Future}
+import scala.concurrent.duration.Duration
+import scala.util.DynamicVariable
 import fun.scop.app.an.util.BioLqmWrapper
 
 class Saf(
     an: AutomataNetwork,
     option: String = "full",
-    satsolver: SatSolver
+    satsolver: SatSolver,
+    verbose: Boolean = true,
+    timeLimit: Double = 0,
+    transfer: Option[ClauseTransfer] = None,
+    simulator: Option[NativeSimulator] = None,
+    excluded: Seq[Map[Automata, Int]] = Seq.empty,
+    stats: Option[StatsLog] = None
 ) extends AbstractSolver() {
 
   var dimacsIndex = 0
@@ -320,7 +334,7 @@ class Saf(
 
       // println(s"=== $a")
 
-      val ta = an.transitions.filter(tr => tr.target == a)
+      val ta = an.transitionsOf(a)
       val ca = an.automata2cycles(a)
 
       // println(ta.mkString(","))
@@ -459,6 +473,50 @@ class Saf(
     /* blocking foundSoFar */
     for (fsf <- foundSoFar if fsf.gs.size > 1)
       blockAttractor(fsf, k)
+
+    /* states of the excluded subspaces */
+    for (space <- excluded; i <- 1 to k)
+      addClause(space.toSeq.map { case (a, v) => -x(a, i, v) })
+
+    /* clauses learned about single states of the smaller instances */
+    for (tr <- transfer) {
+      if (k >= 2)
+        for (c <- tr.clauses; i <- 1 to k)
+          addClause(c.map(lit => fromLocal(lit, i)))
+      satsolver.setLearn(tr.maxLength, learn(tr))
+    }
+  }
+
+  /* variable of state i for each variable of the transfer */
+  private lazy val localToInstance: Map[Int, Int => Int] = transfer match {
+    case Some(tr) =>
+      tr.x.collect { case ((a, v), p) if p > 0 =>
+        p -> ((i: Int) => x(a, i, v))
+      } ++ tr.ti.map { case (trans, p) => p -> ((i: Int) => ti(trans, i)) }
+    case None => Map.empty
+  }
+
+  private def fromLocal(lit: Int, i: Int) = {
+    val p = localToInstance(math.abs(lit))(i)
+    if (lit > 0) p else -p
+  }
+
+  /* variables of the instance belonging to a single state, with the state */
+  private lazy val instanceToLocal: Map[Int, (Int, Int)] = transfer match {
+    case Some(tr) =>
+      xx.collect { case ((a, i, v), p) if p > 0 => p -> (i, tr.x(a, v)) } ++
+        ti.map { case ((trans, i), p) => p -> (i, tr.ti(trans)) }
+    case None => Map.empty
+  }
+
+  private def learn(tr: ClauseTransfer)(lits: Seq[Int]) = {
+    val local = lits.flatMap(lit =>
+      instanceToLocal.get(math.abs(lit)).map { case (i, p) =>
+        (i, if (lit > 0) p else -p)
+      }
+    )
+    if (local.size == lits.size && local.map(_._1).distinct.size == 1)
+      tr.collect(local.map(_._2))
   }
 
   private def getValueOfAutomata(a: Automata, s: Int): Int = {
@@ -500,35 +558,79 @@ class Saf(
     }
   }
 
+  /* seconds spent so far in encoding, solving and blocking attractors */
+  var encodeTime = 0.0
+  var solveTime = 0.0
+  var blockTime = 0.0
+  private var lastSolveTime = 0.0
+
+  private def timedSolve() = {
+    val (answer, seconds) = StatsLog.timed(satsolver.solve)
+    lastSolveTime = seconds
+    solveTime += seconds
+    answer
+  }
+
+  /* one record per k, with the counters of the sat solver */
+  private def recordK(k: Int, models: Int, timeout: Boolean) =
+    for (log <- stats)
+      log.record(
+        "k" -> k,
+        "vars" -> dimacsIndex,
+        "clauses" -> nofClauses,
+        "models" -> models,
+        "encode" -> encodeTime,
+        "solve" -> solveTime,
+        "block" -> blockTime,
+        "timeout" -> timeout,
+        "solver" -> satsolver.statistics
+      )
+
   def findAttractorsLeK(
       k: Int,
       attractorsFoundSoFar: Seq[Attractor]
   ): Seq[Attractor] = {
 
     var modelCounter = 0
-    encode(k, attractorsFoundSoFar)
+    if (timeLimit > 0) satsolver.setTimeLimit(timeLimit)
+    encodeTime += StatsLog.timed(encode(k, attractorsFoundSoFar))._2
 
     var attractorsFound = attractorsFoundSoFar
     var result = false
 
-    println(s"k: $k, #Var: ${dimacsIndex}, #Clause: ${nofClauses}")
-    while (satsolver.solve.get) {
+    if (verbose)
+      println(s"k: $k, #Var: ${dimacsIndex}, #Clause: ${nofClauses}")
+    var answer = timedSolve()
+    while (answer.getOrElse(false)) {
       result = true
       modelCounter += 1
-      println(s"#$modelCounter")
       val attractor = getAttractorFromModel(k)
+      for (log <- stats)
+        log.record(
+          "k" -> k,
+          "model" -> modelCounter,
+          "size" -> attractor.gs.size,
+          "solve" -> lastSolveTime
+        )
+      val valid = simulator.forall(_.isValid(attractor))
+      if (!valid) Saf.rejectAttractor(attractor)
       // printTransitionFromModel(k)
       // println(attractor)
-      println(
-        attractor.gs.seq
-          .map(g => g.avs.map(av => av.v).mkString(""))
-          .mkString(" ")
-      )
-      if (k > 1)
+      if (verbose && valid) {
+        println(s"#$modelCounter")
+        println(Saf.formatAttractor(attractor))
+      }
+      if (k > 1 && valid)
         attractorsFound = attractor +: attractorsFound
-      blockAttractor(attractor, k)
+      blockTime += StatsLog.timed(blockAttractor(attractor, k))._2
+      answer = timedSolve()
     }
-    if (!result) println("None")
+    if (answer.isEmpty) {
+      timedOut = true
+      if (verbose) println("Timeout")
+    } else if (!result && verbose) println("None")
+    transfer.foreach(_.verify(attractorsFound))
+    recordK(k, modelCounter, answer.isEmpty)
 
     attractorsFound
   }
@@ -539,29 +641,46 @@ class Saf(
   ): Seq[Attractor] = {
 
     var modelCounter = 0
-    encode(k, attractorsFoundSoFar)
+    if (timeLimit > 0) satsolver.setTimeLimit(timeLimit)
+    encodeTime += StatsLog.timed(encode(k, attractorsFoundSoFar))._2
 
     var attractorsFound = attractorsFoundSoFar
     var result = false
 
-    println(s"k: $k, #Var: ${dimacsIndex}, #Clause: ${nofClauses}")
-    while (satsolver.solve.get) {
+    if (verbose)
+      println(s"k: $k, #Var: ${dimacsIndex}, #Clause: ${nofClauses}")
+    var answer = timedSolve()
+    while (answer.getOrElse(false)) {
       result = true
       modelCounter += 1
-      println(s"#$modelCounter")
       val attractor = getAttractorFromModel(k)
+      for (log <- stats)
+        log.record(
+          "k" -> k,
+          "model" -> modelCounter,
+          "size" -> attractor.gs.size,
+          "solve" -> lastSolveTime
+        )
+      val valid = simulator.forall(_.isValid(attractor))
+      if (!valid) Saf.rejectAttractor(attractor)
       // printTransitionFromModel(k)
       // println(attractor)
-      println(
-        attractor.gs.seq
-          .map(g => g.avs.map(av => av.v).mkString(""))
-          .mkString(" ")
-      )
+      if (verbose && valid) {
+        println(s"#$modelCounter")
+        println(Saf.formatAttractor(attractor))
+      }
 
-      attractorsFound = attractor +: attractorsFound
-      blockAttractor(attractor, k)
+      if (valid)
+        attractorsFound = attractor +: attractorsFound
+      blockTime += StatsLog.timed(blockAttractor(attractor, k))._2
+      answer = timedSolve()
     }
-    if (!result) println("None")
+    if (answer.isEmpty) {
+      timedOut = true
+      if (verbose) println("Timeout")
+    } else if (!result && verbose) println("None")
+    transfer.foreach(_.verify(attractorsFound))
+    recordK(k, modelCounter, answer.isEmpty)
 
     attractorsFound
   }
@@ -577,6 +696,22 @@ object Saf {
   var k = Int.MaxValue
   var option = "full"
   var isBooleanNetwork = false
+  var reduce = false
+  var modular = false
+  var trapSpace = false
+  var trapSpaceComplete = false
+  var portfolio = false
+  var batch: Option[String] = None
+  var threads = Runtime.getRuntime.availableProcessors
+  var timeout = 0.0
+  var transferClauses = false
+  var validate: Option[String] = None
+  var statsFile: Option[String] = None
+  var cacheDir: Option[String] = None
+  private var nativeSimulator: Option[NativeSimulator] = None
+
+  // scoped to the network being solved, networks of a batch run concurrently
+  private val statsLog = new DynamicVariable[Option[StatsLog]](None)
 
   def parseOptions(arguments: List[String]): List[String] = arguments match {
     case "-h" :: rest => {
@@ -611,6 +746,55 @@ object Saf {
       isBooleanNetwork = true
       parseOptions(rest)
     }
+    case "-reduce" :: rest => {
+      reduce = true
+      parseOptions(rest)
+    }
+    case "-modular" :: rest => {
+      modular = true
+      parseOptions(rest)
+    }
+    case "-trapspace" :: rest => {
+      trapSpace = true
+      parseOptions(rest)
+    }
+    case "-trapspace-complete" :: rest => {
+      trapSpace = true
+      trapSpaceComplete = true
+      parseOptions(rest)
+    }
+    case "-portfolio" :: rest => {
+      portfolio = true
+      parseOptions(rest)
+    }
+    case "-batch" :: manifest :: rest => {
+      batch = Some(manifest)
+      parseOptions(rest)
+    }
+    case "-threads" :: n :: rest => {
+      threads = n.toInt
+      parseOptions(rest)
+    }
+    case "-timeout" :: sec :: rest => {
+      timeout = sec.toDouble
+      parseOptions(rest)
+    }
+    case "-transfer" :: rest => {
+      transferClauses = true
+      parseOptions(rest)
+    }
+    case "-validate" :: path :: rest => {
+      validate = Some(path)
+      parseOptions(rest)
+    }
+    case "-stats" :: path :: rest => {
+      statsFile = Some(path)
+      parseOptions(rest)
+    }
+    case "-cache" :: dir :: rest => {
+      cacheDir = Some(dir)
+      parseOptions(rest)
+    }
     case _ => arguments
   }
 
@@ -628,6 +812,210 @@ object Saf {
     println(
       "\t-encode <cycle|symmetry|full>						: encoding option (default full)"
     )
+    println(
+      "\t-reduce								: reduce the network before encoding (k bounds the reduced attractors)"
+    )
+    println(
+      "\t-modular								: solve the SCCs of the interaction graph separately (k bounds the module attractors)"
+    )
+    println(
+      "\t-trapspace								: solve each minimal trap space separately (attractors outside all of them are missed)"
+    )
+    println(
+      "\t-trapspace-complete							: as -trapspace, then also solve the whole network outside the minimal trap spaces"
+    )
+    println(
+      "\t-timeout <SEC>								: time limit for each k, larger k are skipped once exceeded"
+    )
+    println(
+      "\t-transfer								: reuse clauses learned about single states for larger k (IPASIR only)"
+    )
+    println(
+      "\t-validate <Library Path>						: check every attractor found with the simulator libansim in the directory, dropping invalid ones (exit status 1)"
+    )
+    println(
+      "\t-portfolio								: race Sat4j and CaDiCaL (sat, unsat and plain presets) on every k (CaDiCaL library only)"
+    )
+    println(
+      "\t-batch <Manifest>							: solve the networks listed in the file (one path per line) instead of inputFile"
+    )
+    println(
+      "\t-threads <INT>								: number of networks solved at once in batch mode (default #cores)"
+    )
+    println(
+      "\t-stats <File>								: append timings and solver counters of every k and model to the file as JSON lines"
+    )
+    println(
+      "\t-cache <Directory>							: keep the k=1 instances given to the K1 solver in the directory and reuse them"
+    )
+  }
+
+  def formatAttractor(attractor: Attractor) =
+    attractor.gs
+      .map(g => g.avs.map(av => av.v).mkString(""))
+      .mkString(" ")
+
+  private def newClauseTransfer(an: AutomataNetwork) =
+    if (transferClauses) Some(new ClauseTransfer(an)) else None
+
+  private def ipasirSatSolver(libname: String, libpath: String): SatSolver =
+    if (portfolio) PortfolioSatSolver.withCadical(libname, libpath)
+    else new PureIpasirSatSolver(libname, libpath)
+
+  private def newSatSolver(): SatSolver =
+    (libname, libpath) match {
+      case (Some(name), Some(path)) => ipasirSatSolver(name, path)
+      case _                        => new Sat4j()
+    }
+
+  /* all attractors of an of size at most maxK (outside the excluded
+   * subspaces), in the order they are found
+   */
+  def findAllAttractors(
+      an: AutomataNetwork,
+      maxK: Int,
+      satSolver: () => SatSolver,
+      excluded: Seq[Map[Automata, Int]] = Seq.empty
+  ): Seq[Attractor] = {
+    if (an.automatas.isEmpty)
+      return Seq(Attractor(Seq(GlobalState(Seq.empty))))
+
+    an.calcCycles()
+    val bound = an.stateSpaceSize.min(BigInt(maxK)).toInt
+    var foundSoFar = Seq.empty[Attractor]
+    var timedOut = false
+    val clauseTransfer = newClauseTransfer(an)
+    for (i <- (1 to bound).iterator.takeWhile(_ => !timedOut)) {
+      val sat = satSolver()
+      val solver = new Saf(
+        an,
+        option,
+        sat,
+        verbose = false,
+        timeLimit = timeout,
+        transfer = clauseTransfer,
+        excluded = excluded,
+        stats = statsLog.value
+      )
+      try {
+        foundSoFar = solver.findAttractorsLeKApp(i, foundSoFar)
+        timedOut = solver.timedOut
+      } finally sat.release()
+    }
+    if (timedOut)
+      println(s"Timeout: attractors may be missing")
+    foundSoFar.reverse
+  }
+
+  private def launchStaged(an: AutomataNetwork) = {
+    val stages = Seq(
+      if (reduce) Some("network reduction") else None,
+      if (modular) Some("modular decomposition") else None,
+      if (trapSpaceComplete) Some("minimal trap spaces (complete)")
+      else if (trapSpace) Some("minimal trap spaces")
+      else None
+    ).flatten.mkString(" and ")
+    if (libname.isDefined)
+      println(s"Using IPASIR SAT Solver with $stages")
+    else
+      println(s"Using Sat4j SAT Solver with $stages")
+    println(s"\n${an.automatas.map(a => a.name).mkString(",")}")
+
+    printAttractors(stagedAttractors(an), nativeSimulator)
+  }
+
+  /* attractors of an through the stages selected by the options */
+  private def stagedAttractors(an: AutomataNetwork): Seq[Attractor] = {
+    val networks =
+      if (reduce) NetworkReduction.reduce(an)
+      else Seq(ReducedNetwork(an, an, Map.empty, Seq.empty))
+
+    val (attractors, seconds) = StatsLog.timed(networks.flatMap { rn =>
+      if (reduce)
+        println(s"Reduced: $rn")
+      val attractors =
+        if (trapSpace)
+          new TrapSpaceSolver(
+            rn.an,
+            k,
+            () => newSatSolver(),
+            complete = trapSpaceComplete
+          ).findAttractors
+        else if (modular)
+          new ModularSolver(rn.an, k, () => newSatSolver()).findAttractors
+        else
+          findAllAttractors(rn.an, k, () => newSatSolver())
+      attractors.flatMap(rn.lift)
+    })
+    for (log <- statsLog.value)
+      log.record("attractors" -> attractors.size, "total" -> seconds)
+    attractors
+  }
+
+  /* attractors rejected by -validate, which make the exit status 1 */
+  private val invalidAttractors = new AtomicInteger
+
+  def rejectAttractor(att: Attractor) = {
+    invalidAttractors.incrementAndGet()
+    println(s"Invalid attractor: ${formatAttractor(att)}")
+  }
+
+  private def printAttractors(
+      attractors: Seq[Attractor],
+      simulator: Option[NativeSimulator]
+  ) = {
+    val valid = simulator.fold(attractors)(_.filterAttractors(attractors))
+    attractors.diff(valid).foreach(rejectAttractor)
+    for ((att, i) <- valid.zipWithIndex) {
+      println(s"#${i + 1}")
+      println(formatAttractor(att))
+    }
+    if (valid.isEmpty) println("None")
+  }
+
+  /* networks of the manifest solved concurrently in this JVM, the output of
+   * each network being printed in manifest order once it is complete
+   */
+  private def launchBatch(manifest: String) = {
+    val src = scala.io.Source.fromFile(manifest)
+    val files = src.getLines().map(_.trim).filter(l => l.nonEmpty && !l.startsWith("#")).toList
+    src.close()
+
+    if (libname.isDefined)
+      println(s"Using IPASIR SAT Solver on ${files.size} networks with $threads threads")
+    else
+      println(s"Using Sat4j SAT Solver on ${files.size} networks with $threads threads")
+
+    val log = statsFile.map(new StatsLog(_))
+    val pool = Executors.newFixedThreadPool(threads)
+    implicit val ec = ExecutionContext.fromExecutorService(pool)
+
+    val runs = files.map { file =>
+      Future {
+        val out = new ByteArrayOutputStream
+        Console.withOut(new PrintStream(out, true)) {
+          statsLog.withValue(log.map(_.forNetwork(file))) {
+            try {
+              val an = getAN(file)
+              an.calcCycles()
+              val simulator = validate.map(path => new NativeSimulator(an, "ansim", path))
+              println(s"${an.automatas.map(a => a.name).mkString(",")}")
+              printAttractors(stagedAttractors(an), simulator)
+              simulator.foreach(_.release())
+            } catch {
+              case e: Exception => println(s"Error: $e")
+            }
+          }
+        }
+        out.toString
+      }
+    }
+    for ((file, run) <- files.zip(runs)) {
+      println(s"\n== $file")
+      print(Await.result(run, Duration.Inf))
+    }
+    pool.shutdown()
+    log.foreach(_.close())
   }
 
   private def launchAnIpasirBddSolver(
@@ -643,18 +1031,29 @@ object Saf {
     println(s"\n${an.automatas.map(a => a.name).mkString(",")}")
 
     var foundSoFar = Seq.empty[Attractor]
-    for (i <- 1 to k) {
-      val solver =
-        if (i != 1)
+    var timedOut = false
+    val clauseTransfer = newClauseTransfer(an)
+    for (i <- (1 to k).iterator.takeWhile(_ => !timedOut)) {
+      val sat = if (i != 1) Some(ipasirSatSolver(libname, libpath)) else None
+      val solver = sat match {
+        case Some(s) =>
           new Saf(
             an,
             option,
-            new PureIpasirSatSolver(libname, libpath)
+            s,
+            timeLimit = timeout,
+            transfer = clauseTransfer,
+            simulator = nativeSimulator,
+            stats = statsLog.value
           )
-        else new SafK1(an, sat2bdd)
-
-      val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
-      foundSoFar = foundSoFar ++ foundAtI
+        case None =>
+          new SafK1(an, sat2bdd, cache = cacheDir.map(new CnfCache(_)))
+      }
+      try {
+        val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
+        foundSoFar = foundSoFar ++ foundAtI
+        timedOut = solver.timedOut
+      } finally sat.foreach(_.release())
     }
   }
   private def launchAnIpasirSolver(
@@ -662,17 +1061,33 @@ object Saf {
       libname: String,
       libpath: String
   ) = {
-    println(s"Using IPASIR SAT Solver")
+    if (portfolio)
+      println(s"Using IPASIR SAT Solver in a portfolio with Sat4j")
+    else
+      println(s"Using IPASIR SAT Solver")
     println(s"Libpath: $libpath")
     println(s"Libname: $libname")
     println(s"\n${an.automatas.map(a => a.name).mkString(",")}")
 
     var foundSoFar = Seq.empty[Attractor]
-    for (i <- 1 to k) {
-      val solver =
-        new Saf(an, option, new PureIpasirSatSolver(libname, libpath))
-      val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
-      foundSoFar = foundSoFar ++ foundAtI
+    var timedOut = false
+    val clauseTransfer = newClauseTransfer(an)
+    for (i <- (1 to k).iterator.takeWhile(_ => !timedOut)) {
+      val sat = ipasirSatSolver(libname, libpath)
+      val solver = new Saf(
+        an,
+        option,
+        sat,
+        timeLimit = timeout,
+        transfer = clauseTransfer,
+        simulator = nativeSimulator,
+        stats = statsLog.value
+      )
+      try {
+        val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
+        foundSoFar = foundSoFar ++ foundAtI
+        timedOut = solver.timedOut
+      } finally sat.release()
     }
   }
 
@@ -685,13 +1100,29 @@ object Saf {
     println(s"\n${an.automatas.map(a => a.name).mkString(",")}")
 
     var foundSoFar = Seq.empty[Attractor]
-    for (i <- 1 to k) {
-      val solver =
-        if (i != 1) new Saf(an, option, new Sat4j())
-        else new SafK1(an, sat2bdd)
-
-      val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
-      foundSoFar = foundSoFar ++ foundAtI
+    var timedOut = false
+    val clauseTransfer = newClauseTransfer(an)
+    for (i <- (1 to k).iterator.takeWhile(_ => !timedOut)) {
+      val sat = if (i != 1) Some(new Sat4j()) else None
+      val solver = sat match {
+        case Some(s) =>
+          new Saf(
+            an,
+            option,
+            s,
+            timeLimit = timeout,
+            transfer = clauseTransfer,
+            simulator = nativeSimulator,
+            stats = statsLog.value
+          )
+        case None =>
+          new SafK1(an, sat2bdd, cache = cacheDir.map(new CnfCache(_)))
+      }
+      try {
+        val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
+        foundSoFar = foundSoFar ++ foundAtI
+        timedOut = solver.timedOut
+      } finally sat.foreach(_.release())
     }
 
   }
@@ -702,10 +1133,24 @@ object Saf {
     println(s"\n${an.automatas.map(a => a.name).mkString(",")}")
 
     var foundSoFar = Seq.empty[Attractor]
-    for (i <- 1 to k) {
-      val solver = new Saf(an, option, new Sat4j())
-      val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
-      foundSoFar = foundSoFar ++ foundAtI
+    var timedOut = false
+    val clauseTransfer = newClauseTransfer(an)
+    for (i <- (1 to k).iterator.takeWhile(_ => !timedOut)) {
+      val sat = new Sat4j()
+      val solver = new Saf(
+        an,
+        option,
+        sat,
+        timeLimit = timeout,
+        transfer = clauseTransfer,
+        simulator = nativeSimulator,
+        stats = statsLog.value
+      )
+      try {
+        val foundAtI = solver.findAttractorsLeK(i, foundSoFar)
+        foundSoFar = foundSoFar ++ foundAtI
+        timedOut = solver.timedOut
+      } finally sat.release()
     }
 
   }
@@ -718,12 +1163,7 @@ object Saf {
       val anParser = AutomataNetworkParser(inputFilePath)
       anParser.parse()
     } else {
-      val bioLQM = new BioLqmWrapper()
-      val anFilePath =
-        bioLQM.convertOtherNetworkToAutomataNetwork(inputFilePath)
-      val anParser = AutomataNetworkParser(anFilePath)
-      new java.io.File(anFilePath).deleteOnExit()
-      anParser.parse()
+      new BioLqmWrapper().toAutomataNetwork(inputFilePath)
     }
 
   }
@@ -731,13 +1171,22 @@ object Saf {
   def main(args: Array[String]): Unit = {
 
     val input: String = parseOptions(args.toList) match {
+      case Nil if batch.isDefined && !help => {
+        if (libname.isDefined != libpath.isDefined) {
+          println(s"libname and libpath must be given together.")
+          System.exit(1);
+        }
+        launchBatch(batch.get)
+        if (invalidAttractors.get > 0) System.exit(1)
+        return
+      }
       case file :: Nil if !help =>
         file
       case _ => {
         if (!help)
             println(s"Something wrong in arguments: ${args.mkString(" ")}")
         println(
-          "Usage: java -jar saf.jar [options] [inputFile]"
+          "Usage: java -jar saf.jar [options] [inputFile | -batch <Manifest>]"
         )
         showOptions
         System.exit(1)
@@ -749,8 +1198,18 @@ object Saf {
 
     val an = getAN(input) // anParser.parse()
     an.calcCycles()
+    nativeSimulator = validate.map(path => new NativeSimulator(an, "ansim", path))
+    statsLog.value = statsFile.map(new StatsLog(_).forNetwork(input))
+    if (portfolio && libname.isEmpty)
+      println(s"-portfolio needs the CaDiCaL library (-libname and -libpath), ignored.")
 
-    (libname.isDefined, libpath.isDefined, k1solver.isDefined) match {
+    if (reduce || modular || trapSpace) {
+      if (libname.isDefined != libpath.isDefined) {
+        println(s"libname and libpath must be given together.")
+        System.exit(1);
+      }
+      launchStaged(an)
+    } else (libname.isDefined, libpath.isDefined, k1solver.isDefined) match {
       case (true, true, true) =>
         launchAnIpasirBddSolver(an, libname.get, libpath.get, k1solver.get)
       case (true, true, false) =>
@@ -768,6 +1227,7 @@ object Saf {
         System.exit(1);
       }
     }
+    if (invalidAttractors.get > 0) System.exit(1)
 
   }
 }
@@ -0,0 +1,57 @@
+package fun.scop.app.an.solver
+
+import java.io.{FileWriter, PrintWriter}
+import java.util.Locale
+
+/* JSON lines appended to a file, one object per record.  The logs returned
+ * by forNetwork share the file and add the name of the network to their
+ * records, so that the networks of a batch can be told apart.
+ */
+class StatsLog private (out: PrintWriter, network: Option[String]) {
+
+  def this(path: String) =
+    this(new PrintWriter(new FileWriter(path, true)), None)
+
+  def forNetwork(name: String) = new StatsLog(out, Some(name))
+
+  def record(fields: (String, Any)*): Unit = {
+    val all = network.map("network" -> _).toSeq ++ fields
+    val line = all
+      .map { case (name, value) => s"${StatsLog.quote(name)}:${StatsLog.json(value)}" }
+      .mkString("{", ",", "}")
+    out.synchronized {
+      out.println(line)
+      out.flush()
+    }
+  }
+
+  def close(): Unit = out.close()
+}
+
+object StatsLog {
+
+  def quote(s: String) =
+    "\"" + s.flatMap {
+      case '"'          => "\\\""
+      case '\\'         => "\\\\"
+      case c if c < ' ' => f"\\u${c.toInt}%04x"
+      case c            => c.toString
+    } + "\""
+
+  def json(value: Any): String = value match {
+    case d: Double                         => "%.6f".formatLocal(Locale.ROOT, d)
+    case n @ (_: Int | _: Long | _: Boolean) => n.toString
+    case m: Map[_, _] =>
+      m.toSeq
+        .map { case (k, v) => s"${quote(k.toString)}:${json(v)}" }
+        .mkString("{", ",", "}")
+    case s => quote(s.toString)
+  }
+
+  /* result of body and the seconds it took */
+  def timed[T](body: => T): (T, Double) = {
+    val start = System.nanoTime
+    val result = body
+    (result, (System.nanoTime - start) / 1e9)
+  }
+}
@@ -0,0 +1,107 @@
+package fun.scop.app.an.solver
+
+import fun.scop.app.an.util._
+import fun.scop.sat._
+
+/* Attractors computed inside the minimal trap spaces of an, a trap space
+ * being a subspace (some automata fixed, the others free) that no transition
+ * leaves.  Every minimal trap space contains an attractor, which is searched
+ * with only the free automata encoded.  Attractors outside every minimal trap
+ * space can still exist, which are only searched if complete is set, by
+ * encoding the whole network with the minimal trap spaces excluded.
+ */
+class TrapSpaceSolver(
+    an: AutomataNetwork,
+    maxK: Int,
+    satSolver: () => SatSolver,
+    maxSpaces: Int = 1024,
+    complete: Boolean = false
+) {
+
+  /* minimal trap spaces given by the values of their fixed automata, None
+   * when there are more than maxSpaces of them
+   */
+  lazy val minimalTrapSpaces: Option[Seq[Map[Automata, Int]]] = {
+    var nofVars = 0
+    val f = (for (a <- an.automatas; v <- an.domain(a)) yield {
+      nofVars += 1
+      (a, v) -> nofVars
+    }).toMap
+    val sat = new Sat4j()
+    sat.sat4j.newVar(nofVars)
+
+    // an automaton is fixed to at most one value
+    for (a <- an.automatas; Seq(v, w) <- an.domain(a).combinations(2))
+      sat.addClause(Seq(-f(a, v), -f(a, w)))
+    // a transition of a fixed automaton cannot be fired inside the space
+    for (tr <- an.transitions if tr.origin.v != tr.destination.v) {
+      val disabled = for {
+        c <- tr.condition
+        v <- an.domain(c.a) if v != c.v
+      } yield f(c.a, v)
+      sat.addClause(-f(tr.target, tr.origin.v) +: disabled)
+    }
+
+    def fixedInModel() =
+      (for (((a, v), p) <- f if sat.model(p) > 0) yield a -> v).toMap
+
+    var spaces = Seq.empty[Map[Automata, Int]]
+    var selector = nofVars
+    while (spaces.size <= maxSpaces && sat.solve.get) {
+      // fix one more automaton as long as the space stays a trap space
+      var space = fixedInModel()
+      var extended = true
+      while (extended) {
+        selector += 1
+        val free = an.automatas.filterNot(space.contains)
+        sat.addClause(-selector +: (for (a <- free; v <- an.domain(a)) yield f(a, v)))
+        val fixed = space.map { case (a, v) => f(a, v) }.toSeq
+        extended = sat.solve(selector +: fixed).get
+        if (extended)
+          space = fixedInModel()
+        sat.addClause(Seq(-selector))
+      }
+      spaces = spaces :+ space
+
+      // the next trap spaces are disjoint from this one
+      sat.addClause(for ((a, v) <- space.toSeq; w <- an.domain(a) if w != v) yield f(a, w))
+    }
+
+    if (spaces.size > maxSpaces) None else Some(spaces)
+  }
+
+  def findAttractors: Seq[Attractor] = minimalTrapSpaces match {
+    case Some(spaces) if !spaces.exists(_.isEmpty) => {
+      val nofFree = spaces.map(space => an.automatas.size - space.size)
+      println(s"#Minimal trap spaces: ${spaces.size}, " +
+        s"#Free automata: ${nofFree.mkString("[", ",", "]")}")
+
+      val inside = spaces.flatMap { space =>
+        val free = an.automatas.filterNot(space.contains)
+        val sub = AutomataNetwork(
+          free,
+          free.map(a => a -> an.domain(a)).toMap,
+          NetworkReduction.substitute(an.transitions, space)
+        )
+        Saf
+          .findAllAttractors(sub, maxK, satSolver)
+          .flatMap(ReducedNetwork(an, sub, space, Seq.empty).lift)
+      }
+      if (complete)
+        inside ++ Saf.findAllAttractors(an, maxK, satSolver, excluded = spaces)
+      else {
+        println("Attractors outside the minimal trap spaces are not searched")
+        inside
+      }
+    }
+    case Some(_) => {
+      println("The whole state space is the minimal trap space")
+      Saf.findAllAttractors(an, maxK, satSolver)
+    }
+    case None => {
+      println(s"More than $maxSpaces minimal trap spaces, solving the whole network")
+      Saf.findAllAttractors(an, maxK, satSolver)
+    }
+  }
+
+}
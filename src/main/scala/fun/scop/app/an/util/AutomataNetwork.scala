@@ -51,7 +51,7 @@ case class AutomataNetwork(
     for (a <- automatas) {
 
       // all transitions make automata a different
-      val transitionsForA = transitions.filter(t => t.target == a)
+      val transitionsForA = transitionsOf(a)
 
       // all arcs given by the transitions
       val arcs = transitionsForA.map(t => (t.origin.v, t.destination.v)).toSet
@@ -94,61 +94,77 @@ case class AutomataNetwork(
     }
   }
 
+  // position of each transition in `transitions`; relation queries answer in this order
+  private lazy val transitionIndex: Map[Transition, Int] =
+    transitions.zipWithIndex.toMap
+
+  lazy val transitionsByTarget: Map[Automata, Seq[Transition]] =
+    transitions.groupBy(_.target)
+
+  def transitionsOf(a: Automata): Seq[Transition] =
+    transitionsByTarget.getOrElse(a, Seq.empty)
+
+  // inverted indices: automaton -> value -> transitions mentioning a=value
+  private def indexBy(
+      f: Transition => Seq[AutomataValued]
+  ): Map[Automata, Map[Int, Seq[Transition]]] =
+    transitions
+      .flatMap(t => f(t).distinct.map(av => (av, t)))
+      .groupBy(_._1.a)
+      .map { case (a, avts) =>
+        a -> avts.groupBy(_._1.v).map { case (v, ts) => v -> ts.map(_._2) }
+      }
+
+  private lazy val preIndex = indexBy(_.pre)
+  private lazy val sucsucIndex = indexBy(_.sucsuc)
+
+  // transitions having a=v' in the indexed part for some a=v in avs with v' != v
+  private def conflictingWith(
+      index: Map[Automata, Map[Int, Seq[Transition]]],
+      avs: Seq[AutomataValued]
+  ): Seq[Transition] = {
+    val found = for {
+      av <- avs.distinct
+      (v, ts) <- index.getOrElse(av.a, Map.empty[Int, Seq[Transition]])
+      if v != av.v
+      t0 <- ts
+    } yield t0
+    found.distinct.sortBy(transitionIndex)
+  }
+
   def PreOfTs_conflictWith_PreOf(t: Transition) =
-    transitions.filter(t0 =>
-      t0.pre.exists(v0 => t.pre.exists(v1 => v0.conflictWith(v1)))
-    )
+    conflictingWith(preIndex, t.pre)
 
   def SucOfTs_conflictWith_PreOf(t: Transition) =
-    transitions.filter(t0 =>
-      t0.sucsuc.exists(v0 => t.pre.exists(v1 => v0.conflictWith(v1)))
-    )
+    conflictingWith(sucsucIndex, t.pre)
 
   def PreOfTs_conflictWith_SucOf(t: Transition) =
-    transitions.filter(t0 =>
-      t0.pre.exists(v0 => t.sucsuc.exists(v1 => v0.conflictWith(v1)))
-    )
+    conflictingWith(preIndex, t.sucsuc)
 
   def SucOfTs_conflictWith_SucOf(t: Transition) =
-    transitions.filter(t0 =>
-      t0.sucsuc.exists(v0 => t.sucsuc.exists(v1 => v0.conflictWith(v1)))
-    )
+    conflictingWith(sucsucIndex, t.sucsuc)
 
-  def tsNotPlayableAtaTimeWith(t: Transition) =
+  def tsNotPlayableAtaTimeWith(t: Transition) = {
+    val conflicts = PreOfTs_conflictWith_PreOf(t).toSet
     transitions.filter(t0 =>
-      t0.origin != t.origin || t0.destination != t.destination || t0.pre.exists(
-        v0 => t.pre.exists(v => v0.conflictWith(v))
-      )
+      t0.origin != t.origin || t0.destination != t.destination || conflicts(t0)
     )
+  }
 
-  val ppMap = transitions.map(t => t -> PreOfTs_conflictWith_PreOf(t)).toMap
-  val spMap = transitions.map(t => t -> SucOfTs_conflictWith_PreOf(t)).toMap
-  val psMap = transitions.map(t => t -> PreOfTs_conflictWith_SucOf(t)).toMap
-  val ssMap = transitions.map(t => t -> SucOfTs_conflictWith_SucOf(t)).toMap
-
-  val npMap = transitions.map(t => t -> tsNotPlayableAtaTimeWith(t)).toMap
-
-  val exclusiveByPre: Seq[(Transition, Transition)] = for {
-    i <- 0 until transitions.size
-    j <- i + 1 until transitions.size
-    overlap = transitions(i).pre
-      .map(_.a)
-      .toSet
-      .intersect(transitions(j).pre.map(_.a).toSet)
-    if overlap.exists(a =>
-      transitions(i).getPreValue(a) != transitions(j).getPreValue(a)
-    )
-  } yield (transitions(i), transitions(j))
-
-  val exclusiveBySuc: Seq[(Transition, Transition)] = for {
-    i <- 0 until transitions.size
-    j <- i + 1 until transitions.size
-    if transitions(i).destination.a == transitions(
-      j
-    ).destination.a && transitions(i).destination.v != transitions(
-      j
-    ).destination.v
-  } yield (transitions(i), transitions(j))
+  lazy val exclusiveByPre: Seq[(Transition, Transition)] = for {
+    (t0, i) <- transitions.zipWithIndex
+    t1 <- PreOfTs_conflictWith_PreOf(t0)
+    if transitionIndex(t1) > i
+  } yield (t0, t1)
+
+  lazy val exclusiveBySuc: Seq[(Transition, Transition)] = for {
+    (t0, i) <- transitions.zipWithIndex
+    t1 <- transitionsOf(t0.destination.a)
+    if transitionIndex(t1) > i && t1.destination.v != t0.destination.v
+  } yield (t0, t1)
+
+  def stateSpaceSize: BigInt =
+    automatas.map(a => BigInt(domain(a).size)).product
 
   def stats = Map(
     "Number of Automata: " -> automatas.size,
@@ -211,13 +227,13 @@ object AutomataNetwork {
       println("==========")
       println(t0)
       println("==========")
-      an.ppMap(t0).foreach(println)
+      an.PreOfTs_conflictWith_PreOf(t0).foreach(println)
       println("-")
-      an.spMap(t0).foreach(println)
+      an.SucOfTs_conflictWith_PreOf(t0).foreach(println)
       println("-")
-      an.psMap(t0).foreach(println)
+      an.PreOfTs_conflictWith_SucOf(t0).foreach(println)
       println("-")
-      an.ppMap(t0).foreach(println)
+      an.PreOfTs_conflictWith_PreOf(t0).foreach(println)
       println("-")
       an.tsNotPlayableAtaTimeWith(t0).foreach(println)
     }
@@ -3,6 +3,10 @@ package fun.scop.app.an.util
 import org.colomoto.biolqm.service.LQMServiceManager
 import org.colomoto.biolqm.LogicalModel
 import org.colomoto.biolqm.LQMLauncher
+import org.colomoto.biolqm.NodeInfo
+import org.colomoto.mddlib.MDDManager
+
+import scala.collection.JavaConverters._
 
 import org.colomoto.biolqm.io.bnet.BNetFormat
 import org.colomoto.biolqm.io.booleannet.BooleanNetFormat
@@ -33,6 +37,51 @@ class BioLqmWrapper() {
     outputFilePath
   }
 
+  /* the automata network of a model in any format known to bioLQM, built
+   * from the MDDs of its logical functions as the Pint export does (each
+   * automaton moves by one value towards the value of its function) without
+   * going through a temporary .an file
+   */
+  def toAutomataNetwork(inputFilePath: String): AutomataNetwork = {
+    val model: LogicalModel = LQMServiceManager.load(inputFilePath)
+    val ddmanager = model.getMDDManager
+    val components = model.getComponents.asScala.toIndexedSeq
+
+    val as = components.map(n => Automata(n.getNodeID))
+    val domain = components.map(n => Automata(n.getNodeID) -> (0 to n.getMax).toSeq).toMap
+
+    val ts = for {
+      (a, function) <- as.zip(model.getLogicalFunctions)
+      (conditions, target) <- paths(ddmanager, function, Seq.empty)
+      own = conditions.find(_.a == a).map(_.v)
+      others = conditions.filter(_.a != a)
+      v <- domain(a) if own.forall(_ == v) && v != target
+    } yield {
+      val next = if (target > v) v + 1 else v - 1
+      Transition(AutomataValued(a, v), AutomataValued(a, next), others)
+    }
+
+    AutomataNetwork(as, domain, ts)
+  }
+
+  /* conditions along each path of the MDD from node, with the leaf reached */
+  private def paths(
+      ddmanager: MDDManager,
+      node: Int,
+      conditions: Seq[AutomataValued]
+  ): Seq[(Seq[AutomataValued], Int)] = {
+    if (ddmanager.isleaf(node))
+      Seq((conditions, node))
+    else {
+      val variable = ddmanager.getNodeVariable(node)
+      val a = Automata(variable.key.asInstanceOf[NodeInfo].getNodeID)
+      (0 until variable.nbval).flatMap { v =>
+        val child = ddmanager.getChild(node, v)
+        paths(ddmanager, child, conditions :+ AutomataValued(a, v))
+      }
+    }
+  }
+
   def convert(
       inputFilePath: String,
       inputFormat: String,
@@ -0,0 +1,176 @@
+package fun.scop.app.an.util
+
+/* A network obtained from `original` by fixing automata to the values they
+ * take in every attractor (or, for constant automata, to one of their initial
+ * values) and by eliminating automata that no other automaton reads.
+ * `outputs` are the eliminated automata in elimination order together with
+ * their transitions at the time they were eliminated.
+ */
+case class ReducedNetwork(
+    original: AutomataNetwork,
+    an: AutomataNetwork,
+    fixed: Map[Automata, Int],
+    outputs: Seq[(Automata, Seq[Transition])]
+) {
+
+  /* attractors of the original network corresponding to an attractor of `an` */
+  def lift(att: Attractor): Seq[Attractor] = {
+    var current: Seq[Seq[Map[Automata, Int]]] = Seq(att.gs.map(_.avMap))
+    var ts = an.transitions
+
+    // an eliminated automaton never influences the automata present when it
+    // was eliminated, so the attractors above `current` are the terminal SCCs
+    // of the product of `current` with its domain
+    for ((b, tsB) <- outputs.reverse) {
+      val step = ts ++ tsB
+      current = current.flatMap { states =>
+        val product = for (s <- states; v <- original.domain(b)) yield s + (b -> v)
+        StateGraph.terminalSccs(product, NetworkReduction.successors(step))
+      }
+      ts = step
+    }
+
+    current.map(states =>
+      Attractor(states.map(s => GlobalState.fromMap(original, s ++ fixed)))
+    )
+  }
+
+  override def toString = {
+    val vs = fixed.toSeq.sortBy(_._1.name).map { case (a, v) => s"${a.name}=$v" }
+    s"#Automata: ${original.automatas.size} -> ${an.automatas.size}, " +
+      s"#Transition: ${original.transitions.size} -> ${an.transitions.size}, " +
+      s"Fixed: ${vs.mkString("[", ",", "]")}"
+  }
+}
+
+object NetworkReduction {
+
+  /* reduced networks whose attractors, once lifted, are exactly the
+   * attractors of an; constant automata are enumerated as long as the number
+   * of resulting networks stays within maxBranches
+   */
+  def reduce(an: AutomataNetwork, maxBranches: Int = 64): Seq[ReducedNetwork] =
+    reduceFrom(an, Map.empty, an.transitions, maxBranches)
+
+  def successors(ts: Seq[Transition])(s: Map[Automata, Int]) =
+    ts.filter(t => t.pre.forall(av => s.get(av.a).contains(av.v)))
+      .map(t => s + (t.target -> t.destination.v))
+      .distinct
+
+  def valuations(an: AutomataNetwork, as: Seq[Automata]) =
+    as.foldLeft(Seq(Map.empty[Automata, Int])) { (vss, a) =>
+      for (vs <- vss; v <- an.domain(a)) yield vs + (a -> v)
+    }
+
+  /* transitions that can still fire once the automata in values are fixed */
+  def substitute(ts: Seq[Transition], values: Map[Automata, Int]) =
+    ts.filterNot(t => values.contains(t.target))
+      .filterNot(t => t.condition.exists(c => values.get(c.a).exists(_ != c.v)))
+      .map(t => t.copy(condition = t.condition.filterNot(c => values.contains(c.a))))
+
+  private def reduceFrom(
+      an: AutomataNetwork,
+      fixed0: Map[Automata, Int],
+      ts0: Seq[Transition],
+      budget: Int
+  ): Seq[ReducedNetwork] = {
+    val (fixed, ts) = percolate(an, fixed0, ts0)
+
+    // constant automata read by some other automaton
+    val targets = ts.map(_.target).toSet
+    val read = readAutomata(ts)
+    val inputs = an.automatas.filter(a =>
+      !fixed.contains(a) && !targets(a) && read(a) && an.domain(a).size > 1
+    )
+    val nofValuations = inputs.map(a => BigInt(an.domain(a).size)).product
+
+    if (inputs.nonEmpty && nofValuations <= budget) {
+      valuations(an, inputs).flatMap(vs =>
+        reduceFrom(an, fixed ++ vs, ts, (budget / nofValuations).toInt)
+      )
+    } else
+      Seq(eliminateOutputs(an, fixed, ts))
+  }
+
+  private def readAutomata(ts: Seq[Transition]) =
+    ts.flatMap(t => t.condition.map(_.a).filter(_ != t.target)).toSet
+
+  private def percolate(
+      an: AutomataNetwork,
+      fixed0: Map[Automata, Int],
+      ts0: Seq[Transition]
+  ) = {
+    var fixed = fixed0
+    var ts = substitute(ts0, fixed)
+    var found = Map.empty[Automata, Int]
+
+    do {
+      val byTarget = ts.groupBy(_.target)
+      found = (for {
+        a <- an.automatas if !fixed.contains(a)
+        d <- eventualValue(an.domain(a), byTarget.getOrElse(a, Seq.empty))
+      } yield a -> d).toMap
+      fixed ++= found
+      ts = substitute(ts, found)
+    } while (found.nonEmpty)
+
+    (fixed, ts)
+  }
+
+  /* the value every attractor gives to an automaton whose transitions are tsA:
+   * the only value without outgoing transition, provided that every other
+   * value reaches it through unconditional transitions
+   */
+  private def eventualValue(dom: Seq[Int], tsA: Seq[Transition]): Option[Int] = {
+    if (dom.size == 1)
+      return Some(dom.head)
+    if (tsA.isEmpty)
+      return None
+
+    dom.filterNot(v => tsA.exists(_.origin.v == v)) match {
+      case Seq(d) => {
+        val unconditional = tsA.filter(_.condition.isEmpty)
+        var reached = Set(d)
+        var more = Seq(d)
+        while (more.nonEmpty) {
+          more = unconditional
+            .filter(t => reached(t.destination.v) && !reached(t.origin.v))
+            .map(_.origin.v)
+            .distinct
+          reached ++= more
+        }
+        if (dom.forall(reached)) Some(d) else None
+      }
+      case _ => None
+    }
+  }
+
+  private def eliminateOutputs(
+      an: AutomataNetwork,
+      fixed: Map[Automata, Int],
+      ts0: Seq[Transition]
+  ) = {
+    var remaining = an.automatas.filterNot(fixed.contains)
+    var ts = ts0
+    var outputs = Seq.empty[(Automata, Seq[Transition])]
+    var found = Seq.empty[Automata]
+
+    // automata found in the same round do not read each other
+    do {
+      val read = readAutomata(ts)
+      found = remaining.filterNot(read)
+      for (b <- found)
+        outputs = outputs :+ (b -> ts.filter(_.target == b))
+      ts = ts.filterNot(t => found.contains(t.target))
+      remaining = remaining.filterNot(found.contains)
+    } while (found.nonEmpty)
+
+    val reduced = AutomataNetwork(
+      remaining,
+      remaining.map(a => a -> an.domain(a)).toMap,
+      ts
+    )
+    ReducedNetwork(an, reduced, fixed, outputs)
+  }
+
+}
@@ -0,0 +1,73 @@
+package fun.scop.app.an.util
+
+import scala.collection.mutable
+
+object StateGraph {
+
+  /* terminal strongly connected components of the graph reachable from states */
+  def terminalSccs[S](states: Seq[S], successors: S => Seq[S]): Seq[Seq[S]] = {
+    val succ = mutable.HashMap.empty[S, Seq[S]]
+    def next(s: S) = succ.getOrElseUpdate(s, successors(s))
+
+    val components = sccs(states, next)
+    val sccOf = (for ((scc, i) <- components.zipWithIndex; s <- scc) yield s -> i).toMap
+    for {
+      (scc, i) <- components.zipWithIndex
+      if scc.forall(s => next(s).forall(t => sccOf(t) == i))
+    } yield scc
+  }
+
+  /* strongly connected components of the graph reachable from states, every
+   * component coming after all components reachable from it (iterative
+   * Tarjan, so that long paths do not overflow the stack)
+   */
+  def sccs[S](states: Seq[S], next: S => Seq[S]): Seq[Seq[S]] = {
+    var counter = 0
+    val index = mutable.HashMap.empty[S, Int]
+    val lowlink = mutable.HashMap.empty[S, Int]
+    val stack = mutable.ArrayBuffer.empty[S]
+    val onStack = mutable.HashSet.empty[S]
+    val components = mutable.ArrayBuffer.empty[Seq[S]]
+
+    for (root <- states if !index.contains(root)) {
+      val work = mutable.ArrayBuffer.empty[(S, Iterator[S])]
+
+      def visit(s: S) = {
+        index(s) = counter
+        lowlink(s) = counter
+        counter += 1
+        stack += s
+        onStack += s
+        work += ((s, next(s).iterator))
+      }
+
+      visit(root)
+      while (work.nonEmpty) {
+        val (v, it) = work.last
+        if (it.hasNext) {
+          val w = it.next()
+          if (!index.contains(w))
+            visit(w)
+          else if (onStack(w))
+            lowlink(v) = lowlink(v) min index(w)
+        } else {
+          work.remove(work.size - 1)
+          if (work.nonEmpty) {
+            val u = work.last._1
+            lowlink(u) = lowlink(u) min lowlink(v)
+          }
+          if (lowlink(v) == index(v)) {
+            val i = stack.lastIndexOf(v)
+            val scc = stack.drop(i).toList
+            stack.remove(i, stack.size - i)
+            onStack --= scc
+            components += scc
+          }
+        }
+      }
+    }
+
+    components.toList
+  }
+
+}
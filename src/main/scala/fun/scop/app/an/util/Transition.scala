@@ -25,7 +25,7 @@ case class Transition(
   def sucsuc = destination +: condition
 
   def isFireableFrom(gs: GlobalState) = {
-    pre.forall(gs.avs.contains)
+    pre.forall(av => gs.avMap.get(av.a).contains(av.v))
   }
 
   /*
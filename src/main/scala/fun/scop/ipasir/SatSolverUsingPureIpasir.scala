@@ -1,14 +1,28 @@
 package fun.scop.ipasir
 
+import java.nio.{ByteOrder, IntBuffer}
 import java.util
 
 import com.sun.jna.ptr.IntByReference
 import com.sun.jna.{Callback, Library, Native, Pointer, ptr}
 import fun.scop.sat._
 
+import scala.collection.concurrent.TrieMap
 import scala.collection.mutable.ArrayBuffer
 
-case class SatSolverUsingPureIpasir(name: String) {
+class LearnCallback(learn: Seq[Int] => Unit) extends Callback {
+  def invoke(state: Pointer, clause: Pointer): Unit = {
+    val lits = ArrayBuffer.empty[Int]
+    var lit = clause.getInt(0)
+    while (lit != 0) {
+      lits.append(lit)
+      lit = clause.getInt(4 * lits.size)
+    }
+    learn(lits)
+  }
+}
+
+object SatSolverUsingPureIpasir {
 
   trait IPASIR extends Library {
     def ipasir_signature: String
@@ -34,11 +48,51 @@ case class SatSolverUsingPureIpasir(name: String) {
         state: Pointer,
         callback: Callback
     ): Unit
+
+    def ipasir_set_learn(
+        solver: Pointer,
+        state: Pointer,
+        max_length: Int,
+        learn: Callback
+    ): Unit
+
+    def ipasir_set_time_limit(solver: Pointer, seconds: Double): Unit
+
+    def ipasir_set_conflict_limit(solver: Pointer, conflicts: Int): Unit
+
+    def ipasir_set_decision_limit(solver: Pointer, decisions: Int): Unit
+
+    def ipasir_set_interrupt(solver: Pointer, value: Int): Unit
+
+    def ipasir_configure(solver: Pointer, name: String): Int
+
+    def ipasir_set_option(solver: Pointer, name: String, value: Int): Unit
+
+    def ipasir_get_statistic(solver: Pointer, name: String): Long
+
+    def ipasir_pipe_open(solver: Pointer, segments: Int, size: Int): Pointer
+
+    def ipasir_pipe_acquire(solver: Pointer): Int
+
+    def ipasir_pipe_submit(solver: Pointer, segment: Int, count: Int): Unit
+
+    def ipasir_pipe_flush(solver: Pointer): Unit
   }
 
+  private val libraries = TrieMap.empty[String, IPASIR]
+
+  /* loaded once per library name and shared by all solvers */
+  def library(name: String): IPASIR =
+    libraries.getOrElseUpdate(name, Native.load(name, classOf[IPASIR]))
+}
+
+case class SatSolverUsingPureIpasir(name: String) {
+
+  import SatSolverUsingPureIpasir.IPASIR
+
   val solverName = name
   // println("JNA library load: start")
-  val ipasirLib: IPASIR = Native.load(solverName, classOf[IPASIR])
+  val ipasirLib: IPASIR = SatSolverUsingPureIpasir.library(solverName)
   // println("JNA library load: end")
 
   val solverPtr = ipasirLib.ipasir_init
@@ -57,6 +111,7 @@ case class SatSolverUsingPureIpasir(name: String) {
   }
 
   def add(lit_or_zero: Int): Unit = {
+    submitSegment()
     ipasirLib.ipasir_add(solverPtr, lit_or_zero)
   }
 
@@ -85,20 +140,102 @@ case class SatSolverUsingPureIpasir(name: String) {
     }
   }
 
+  // kept here so that the callback is not collected while the solver uses it
+  var learnCallback: Option[LearnCallback] = None
+
+  def setLearn(maxLength: Int, learn: Seq[Int] => Unit): Unit = {
+    learnCallback = Some(new LearnCallback(learn))
+    ipasirLib.ipasir_set_learn(solverPtr, null, maxLength, learnCallback.get)
+  }
+
+  /* native limits, checked inside the solver without calling back the JVM */
+  def setTimeLimit(seconds: Double): Unit =
+    ipasirLib.ipasir_set_time_limit(solverPtr, seconds)
+
+  def setConflictLimit(conflicts: Int): Unit =
+    ipasirLib.ipasir_set_conflict_limit(solverPtr, conflicts)
+
+  def setDecisionLimit(decisions: Int): Unit =
+    ipasirLib.ipasir_set_decision_limit(solverPtr, decisions)
+
+  def setInterrupt(value: Int): Unit =
+    ipasirLib.ipasir_set_interrupt(solverPtr, value)
+
+  /* -1 for counters unknown to the library, or without the accessor */
+  def getStatistic(name: String): Long =
+    try ipasirLib.ipasir_get_statistic(solverPtr, name)
+    catch { case e: UnsatisfiedLinkError => -1 }
+
+  def configure(preset: String): Boolean =
+    ipasirLib.ipasir_configure(solverPtr, preset) != 0
+
+  def setOption(name: String, value: Int): Unit =
+    ipasirLib.ipasir_set_option(solverPtr, name, value)
+
   val bufferOfLits = ArrayBuffer.empty[Int]
   var numberOfBufferedClauses = 0
   var bufsize = 10000
 
-  def addLit(lit: Int): Unit = {
-    bufferOfLits.append(lit)
-    if (bufferOfLits.size == bufsize) {
-      add(bufferOfLits.toArray)
-      bufferOfLits.clear()
+  /* When the library provides a pipe, literals are written in place into
+   * segments of its ring, seen as a direct buffer, and a thread of the
+   * library adds them to the solver while the next segments are filled.
+   * Otherwise they are buffered here and passed by ipasir_add_lits.
+   */
+  val pipeSegments = 4
+  val pipeSegmentSize = 1 << 16
+
+  private val pipe: Option[IntBuffer] =
+    try {
+      Option(
+        ipasirLib.ipasir_pipe_open(solverPtr, pipeSegments, pipeSegmentSize)
+      ).map(
+        _.getByteBuffer(0, 4L * pipeSegments * pipeSegmentSize)
+          .order(ByteOrder.nativeOrder)
+          .asIntBuffer
+      )
+    } catch {
+      case e: UnsatisfiedLinkError => None
+    }
+
+  private var segment = -1
+  private var segmentBuffer: IntBuffer = null
+
+  private def acquireSegment(ring: IntBuffer): Unit = {
+    segment = ipasirLib.ipasir_pipe_acquire(solverPtr)
+    val view = ring.duplicate
+    view.position(segment * pipeSegmentSize)
+    view.limit((segment + 1) * pipeSegmentSize)
+    segmentBuffer = view.slice
+  }
+
+  private def submitSegment(): Unit = {
+    if (segment >= 0)
+      ipasirLib.ipasir_pipe_submit(solverPtr, segment, segmentBuffer.position)
+    segment = -1
+  }
+
+  def addLit(lit: Int): Unit = pipe match {
+    case Some(ring) => {
+      if (segment < 0)
+        acquireSegment(ring)
+      segmentBuffer.put(lit)
+      if (!segmentBuffer.hasRemaining)
+        submitSegment()
+    }
+    case None => {
+      bufferOfLits.append(lit)
+      if (bufferOfLits.size == bufsize) {
+        add(bufferOfLits.toArray)
+        bufferOfLits.clear()
+      }
     }
   }
 
   private def done(): Unit = {
-    if (bufferOfLits.size == 0) return
+    if (pipe.isDefined) {
+      submitSegment()
+      ipasirLib.ipasir_pipe_flush(solverPtr)
+    } else if (bufferOfLits.size == 0) return
     else {
       add(bufferOfLits.toArray)
       bufferOfLits.clear()
@@ -0,0 +1,102 @@
+package fun.scop.sat
+
+import java.util.concurrent.{Executors, ThreadFactory}
+
+import scala.concurrent._
+import scala.concurrent.duration.Duration
+
+/* Several solvers given the same clauses, racing on every solve: the first
+ * answer is kept and the other solvers are interrupted.  Every solver waits
+ * for the others to stop before clauses are added again, so that all of them
+ * stay usable incrementally.
+ */
+class PortfolioSatSolver(members: Seq[SatSolver]) extends SatSolver {
+
+  import PortfolioSatSolver.executionContext
+
+  private var winner: SatSolver = members.head
+
+  def init = members.foreach(_.init)
+
+  override def addClause(lits: Seq[Int]): Unit =
+    members.foreach(_.addClause(lits))
+
+  override def addComment(str: String): Unit = {}
+
+  private def race(solve: SatSolver => Option[Boolean]): Option[Boolean] = {
+    members.foreach(_.setInterrupt(false))
+    val first = Promise[(SatSolver, Option[Boolean])]()
+    val runs = members.map(m =>
+      Future {
+        val result = solve(m)
+        if (result.isDefined)
+          first.trySuccess((m, result))
+        result
+      }
+    )
+    val all = Future.sequence(runs)
+    // no answer when every member reached its time limit
+    all.onComplete(done =>
+      first.tryComplete(done.map(_ => (members.head, None: Option[Boolean])))
+    )
+
+    val answer = Await.ready(first.future, Duration.Inf).value.get
+    members.foreach(_.setInterrupt(true))
+    Await.ready(all, Duration.Inf)
+
+    val (m, result) = answer.get
+    winner = m
+    result
+  }
+
+  def solve: Option[Boolean] = race(_.solve)
+
+  def solve(assumptions: Seq[Int]): Option[Boolean] =
+    race(_.solve(assumptions))
+
+  def model(v: Int): Int = winner.model(v)
+
+  override def statistics: Map[String, Long] = winner.statistics
+
+  override def setTimeLimit(seconds: Double): Unit =
+    members.foreach(_.setTimeLimit(seconds))
+
+  // members report from their own threads
+  override def setLearn(maxLength: Int, learn: Seq[Int] => Unit): Unit =
+    members.foreach(
+      _.setLearn(maxLength, lits => this.synchronized(learn(lits)))
+    )
+
+  override def setInterrupt(value: Boolean): Unit =
+    members.foreach(_.setInterrupt(value))
+
+  override def release(): Unit = members.foreach(_.release())
+}
+
+object PortfolioSatSolver {
+
+  // threads are reused across the solvers of successive k
+  private implicit val executionContext: ExecutionContext =
+    ExecutionContext.fromExecutorService(
+      Executors.newCachedThreadPool(new ThreadFactory {
+        def newThread(r: Runnable) = {
+          val thread = new Thread(r)
+          thread.setDaemon(true)
+          thread
+        }
+      })
+    )
+
+  val cadicalPresets = Seq("sat", "unsat", "plain")
+
+  /* Sat4j and CaDiCaL under each preset, with different seeds */
+  def withCadical(libraryName: String, libraryPath: String) = {
+    val cadicals = for ((preset, seed) <- cadicalPresets.zipWithIndex) yield {
+      val solver = new PureIpasirSatSolver(libraryName, libraryPath)
+      solver.configure(preset)
+      solver.setOption("seed", seed)
+      solver
+    }
+    new PortfolioSatSolver(new Sat4j() +: cadicals)
+  }
+}
@@ -12,10 +12,12 @@ class PureIpasirSatSolver(libraryName: String, libraryPath: String)
 
   def load = {
     // println(s"PureIpasirSatSolver using $libraryName @ $libraryPath")
-    NativeLibrary.addSearchPath(libraryName, libraryPath)
+    PureIpasirSatSolver.addSearchPath(libraryName, libraryPath)
     SatSolverUsingPureIpasir(libraryName)
   }
 
+  override def release(): Unit = satSolver.release()
+
   def init = {}
 
   private[this] def makeReturnValue(code: Int): Option[Boolean] = {
@@ -47,6 +49,27 @@ class PureIpasirSatSolver(libraryName: String, libraryPath: String)
 
   override def model(v: Int): Int = satSolver.`val`(v)
 
+  override def setTimeLimit(seconds: Double): Unit =
+    satSolver.setTimeLimit(seconds)
+
+  override def setLearn(maxLength: Int, learn: Seq[Int] => Unit): Unit =
+    satSolver.setLearn(maxLength, learn)
+
+  override def setInterrupt(value: Boolean): Unit =
+    satSolver.setInterrupt(if (value) 1 else 0)
+
+  override def statistics: Map[String, Long] =
+    PureIpasirSatSolver.counters
+      .map(name => name -> satSolver.getStatistic(name))
+      .filter(_._2 >= 0)
+      .toMap
+
+  /* CaDiCaL option presets and options, before any clause is added */
+  def configure(preset: String): Boolean = satSolver.configure(preset)
+
+  def setOption(name: String, value: Int): Unit =
+    satSolver.setOption(name, value)
+
   override def addClause(lits: Seq[Int]): Unit = {
     for (lit <- lits)
       satSolver.addLit(lit.toInt)
@@ -56,6 +79,32 @@ class PureIpasirSatSolver(libraryName: String, libraryPath: String)
   override def addComment(str: String): Unit = {}
 }
 
+object PureIpasirSatSolver {
+
+  /* counters read from CaDiCaL, memory being the resident set size */
+  val counters = Seq(
+    "conflicts",
+    "decisions",
+    "propagations",
+    "restarts",
+    "learned",
+    "fixed",
+    "memory",
+    "maxmemory"
+  )
+
+  private var searchPaths = Set.empty[(String, String)]
+
+  // JNA keeps every path added, so each one is added once
+  def addSearchPath(libraryName: String, libraryPath: String) =
+    synchronized {
+      if (!searchPaths((libraryName, libraryPath))) {
+        NativeLibrary.addSearchPath(libraryName, libraryPath)
+        searchPaths += ((libraryName, libraryPath))
+      }
+    }
+}
+
 object PureIpasirSatSolverTest {
 
   def getBlockClause(lits: Seq[Int]) = {
@@ -5,7 +5,18 @@ case class Sat4j(option: String = "default") extends SatSolver {
   import org.sat4j.core.VecInt
   import org.sat4j.minisat.SolverFactory
   import org.sat4j.minisat.core.{Solver => MinisatSolver}
-  import org.sat4j.tools.{DimacsStringSolver, ModelIterator}
+  import org.sat4j.specs.{
+    ContradictionException,
+    ISolverService,
+    TimeoutException
+  }
+  import org.sat4j.tools.{
+    DimacsStringSolver,
+    ModelIterator,
+    SearchListenerAdapter
+  }
+
+  import scala.collection.JavaConverters._
 
   // def this() = this("default")
 
@@ -17,7 +28,63 @@ case class Sat4j(option: String = "default") extends SatSolver {
 
   var statmap = sat4j.getStat
 
-  def init = sat4j.reset()
+  // sat4j rejects clauses falsified at the root level by throwing
+  var isUnsat = false
+
+  // sat4j only knows timeouts per call, so the deadline is kept here
+  private var deadline: Option[Long] = None
+
+  override def setTimeLimit(seconds: Double): Unit =
+    deadline =
+      if (seconds > 0) Some(System.nanoTime + (seconds * 1e9).toLong)
+      else None
+
+  private def withDeadline(solve: => Boolean): Option[Boolean] =
+    if (interrupted) None
+    else deadline match {
+      case None =>
+        try Some(solve)
+        catch { case e: TimeoutException => None }
+      case Some(d) => {
+        val remainingMs = (d - System.nanoTime) / 1000000
+        if (remainingMs <= 0) None
+        else {
+          sat4j.setTimeoutMs(remainingMs)
+          try Some(solve)
+          catch { case e: TimeoutException => None }
+        }
+      }
+    }
+
+  // sat4j only stops a running search, a later call starts a fresh timer.
+  // The flag is sticky until cleared: it is checked before every search
+  // and on every search loop, so an interrupt arriving before or while the
+  // search starts is not lost.
+  @volatile private var interrupted = false
+
+  private val interruptListener = new SearchListenerAdapter[ISolverService] {
+    override def beginLoop(): Unit =
+      if (interrupted) sat4j.expireTimeout()
+  }
+
+  // output only solvers such as DimacsStringSolver never search
+  private def listen(): Unit =
+    try sat4j.setSearchListener(interruptListener)
+    catch { case e: UnsupportedOperationException => }
+  listen()
+
+  override def setInterrupt(value: Boolean): Unit = {
+    interrupted = value
+    if (value) sat4j.expireTimeout()
+  }
+
+  override def statistics: Map[String, Long] =
+    statmap.asScala.map { case (name, n) => name -> n.longValue }.toMap
+
+  def init = {
+    sat4j.reset()
+    listen()
+  }
 
   private def minisat: MinisatSolver[_] = sat4j match {
     case x: MinisatSolver[_] => x
@@ -26,7 +93,11 @@ case class Sat4j(option: String = "default") extends SatSolver {
 
   override def addClause(lits: Seq[Int]): Unit = {
     // println(lits.mkString(" "))
-    sat4j.addClause(new VecInt(lits.map(_.toInt).toArray))
+    try {
+      sat4j.addClause(new VecInt(lits.map(_.toInt).toArray))
+    } catch {
+      case e: ContradictionException => isUnsat = true
+    }
   }
 
   override def addComment(str: String): Unit = {}
@@ -42,13 +113,17 @@ case class Sat4j(option: String = "default") extends SatSolver {
   }
 
   def solve = {
-    val res = Some(sat4j.isSatisfiable)
+    val res =
+      if (isUnsat) Some(false)
+      else withDeadline(sat4j.isSatisfiable)
     statmap = sat4j.getStat
     res
   }
 
   def solve(assumptions: Seq[Int]): Option[Boolean] = {
-    val res = Some(sat4j.isSatisfiable(new VecInt(assumptions.toArray)))
+    val res =
+      if (isUnsat) Some(false)
+      else withDeadline(sat4j.isSatisfiable(new VecInt(assumptions.toArray)))
     statmap = sat4j.getStat
     res
   }
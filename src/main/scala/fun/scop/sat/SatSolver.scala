@@ -18,6 +18,21 @@ abstract class SatSolver() extends SatProblem {
 
   def model(v: Int): Int
 
+  /* deadline in seconds from now after which solve gives None (0 removes it) */
+  def setTimeLimit(seconds: Double): Unit = {}
+
+  /* learned clauses of at most maxLength literals are given to learn */
+  def setLearn(maxLength: Int, learn: Seq[Int] => Unit): Unit = {}
+
+  /* asks a running solve (possibly from another thread) to give None */
+  def setInterrupt(value: Boolean): Unit = {}
+
+  /* counters of the solver (conflicts, propagations, ...) after the last solve */
+  def statistics: Map[String, Long] = Map.empty
+
+  /* frees native resources, the solver cannot be used afterwards */
+  def release(): Unit = {}
+
   //  def whoami: String
 }
 
@@ -0,0 +1,113 @@
+package fun.scop.sim
+
+import com.sun.jna.{Library, Native, NativeLibrary, Pointer}
+import fun.scop.app.an.util._
+
+/* asynchronous simulator of an in libansim (see ansim/), which checks states
+ * 64 at a time on bit-sliced words instead of boxed global states
+ */
+class NativeSimulator(
+    an: AutomataNetwork,
+    libraryName: String,
+    libraryPath: String
+) {
+
+  trait ANSIM extends Library {
+    def ansim_new(automata: Int, domain_sizes: Array[Int]): Pointer
+
+    def ansim_release(sim: Pointer): Unit
+
+    def ansim_add_transition(
+        sim: Pointer,
+        automaton: Int,
+        from: Int,
+        to: Int,
+        conditions: Array[Int],
+        size: Int
+    ): Unit
+
+    def ansim_is_fixed_point(sim: Pointer, state: Array[Int]): Int
+
+    def ansim_filter_fixed_points(
+        sim: Pointer,
+        states: Array[Int],
+        size: Int,
+        result: Array[Int]
+    ): Int
+
+    def ansim_is_attractor(sim: Pointer, states: Array[Int], size: Int): Int
+  }
+
+  NativeLibrary.addSearchPath(libraryName, libraryPath)
+  val ansimLib: ANSIM = Native.load(libraryName, classOf[ANSIM])
+
+  // the simulator numbers automata and values from 0
+  private val automataIndex = an.automatas.zipWithIndex.toMap
+  private val valueIndex =
+    an.automatas.map(a => a -> an.domain(a).zipWithIndex.toMap).toMap
+
+  val simPtr = ansimLib.ansim_new(
+    an.automatas.size,
+    an.automatas.map(a => an.domain(a).size).toArray
+  )
+
+  for (tr <- an.transitions) {
+    val a = tr.target
+    val conditions = tr.condition
+      .flatMap(c => Seq(automataIndex(c.a), valueIndex(c.a)(c.v)))
+      .toArray
+    ansimLib.ansim_add_transition(
+      simPtr,
+      automataIndex(a),
+      valueIndex(a)(tr.origin.v),
+      valueIndex(a)(tr.destination.v),
+      conditions,
+      tr.condition.size
+    )
+  }
+
+  private def encode(states: Seq[GlobalState]) =
+    states.flatMap { gs =>
+      an.automatas.map(a =>
+        gs.avMap.get(a).flatMap(valueIndex(a).get).getOrElse(-1)
+      )
+    }.toArray
+
+  def release(): Unit = ansimLib.ansim_release(simPtr)
+
+  def isFixedPoint(gs: GlobalState) =
+    ansimLib.ansim_is_fixed_point(simPtr, encode(Seq(gs))) != 0
+
+  /* the fixed points among states, checked in a single call */
+  def filterFixedPoints(states: Seq[GlobalState]): Seq[GlobalState] = {
+    val result = new Array[Int](states.size)
+    ansimLib.ansim_filter_fixed_points(
+      simPtr,
+      encode(states),
+      states.size,
+      result
+    )
+    for ((gs, r) <- states.zip(result) if r != 0) yield gs
+  }
+
+  /* the states of att form a terminal SCC of the state transition graph */
+  def isAttractor(att: Attractor) =
+    ansimLib.ansim_is_attractor(simPtr, encode(att.gs), att.gs.size) != 0
+
+  /* as isAttractor, but fixed points are only checked for enabled
+   * transitions
+   */
+  def isValid(att: Attractor) =
+    if (att.gs.size == 1) isFixedPoint(att.gs.head) else isAttractor(att)
+
+  /* the attractors among atts in their order, all fixed points being
+   * checked in a single call
+   */
+  def filterAttractors(atts: Seq[Attractor]): Seq[Attractor] = {
+    val fixedPoints =
+      filterFixedPoints(atts.filter(_.gs.size == 1).map(_.gs.head)).toSet
+    atts.filter(att =>
+      if (att.gs.size == 1) fixedPoints(att.gs.head) else isAttractor(att)
+    )
+  }
+}